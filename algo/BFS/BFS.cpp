@@ -0,0 +1,425 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "BFS.h"
+
+#include <iostream>
+#include <ctime>
+
+BFSEdgeIndex::BFSEdgeIndex()
+{
+    this->eCount = -1;
+    this->outOffset = std::vector<int>();
+    this->outDst = std::vector<int>();
+    this->inOffset = std::vector<int>();
+    this->inSrc = std::vector<int>();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+BFS<VertexValueType, MessageValueType>::BFS()
+{
+    this->topDownCount = 0;
+    this->bottomUpCount = 0;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int BFS<VertexValueType, MessageValueType>::MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet)
+{
+    //Activity reset
+    activeVertice.clear();
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //MSG Init
+    auto mValues = std::vector<MessageValueType>(g.vCount * this->numOfInitV, (MessageValueType)INVALID_MASSAGE);
+    for(const auto &m : mSet.mSet)
+    {
+        auto &mv = mValues.at(m.dst * this->numOfInitV + g.vList.at(m.src).initVIndex);
+        if(mv > m.value)
+            mv = m.value;
+    }
+
+    //array form computation
+    this->MSGApply_array(g.vCount, g.eCount, &g.vList[0], this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Active vertices set assembly
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(g.vList.at(i).isActive)
+            activeVertice.insert(i);
+    }
+
+    return activeVertice.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int BFS<VertexValueType, MessageValueType>::MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet)
+{
+    //Generate merged msgs directly
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //mValues init
+    auto mValues = std::vector<MessageValueType>(g.vCount * this->numOfInitV);
+
+    //array form computation
+    this->MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], g.eList.data(), this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Package mMergedMSGValueSet to result mSet
+    for(int i = 0; i < g.vCount * this->numOfInitV; i++)
+    {
+        if(mValues.at(i) != (MessageValueType)INVALID_MASSAGE)
+        {
+            int dst = i / this->numOfInitV;
+            int initV = initVSet[i % this->numOfInitV];
+            mSet.insertMsg(Message<MessageValueType>(initV, dst, mValues.at(i)));
+        }
+    }
+
+    return mSet.mSet.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int BFS<VertexValueType, MessageValueType>::MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues)
+{
+    int avCount = 0;
+
+    for(int i = 0; i < vCount; i++) vSet[i].isActive = false;
+
+    for(int i = 0; i < vCount * numOfInitV; i++)
+    {
+        //A pair is reached only once, by the smallest parent in the frontier
+        if(vValues[i].depth == BFS_UNREACHED && mValues[i] != (MessageValueType)INVALID_MASSAGE)
+        {
+            int parent = (int)mValues[i];
+            vValues[i] = VertexValueType(parent, vValues[parent * numOfInitV + i % numOfInitV].depth + 1);
+            if(!vSet[i / numOfInitV].isActive)
+            {
+                vSet[i / numOfInitV].isActive = true;
+                avCount++;
+            }
+        }
+    }
+
+    return avCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int BFS<VertexValueType, MessageValueType>::MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues)
+{
+    const auto &index = this->getEdgeIndex(vCount, eCount, eSet);
+
+    for(int i = 0; i < vCount * numOfInitV; i++) mValues[i] = (MessageValueType)INVALID_MASSAGE;
+
+    //All initVs start together, so every frontier is at the same depth
+    //which is the deepest depth of active vertices (active vertices are those reached in the last superstep)
+    int level = BFS_UNREACHED;
+    for(int i = 0; i < vCount; i++)
+    {
+        if(!vSet[i].isActive) continue;
+        for(int j = 0; j < numOfInitV; j++)
+        {
+            if(level < vValues[i * numOfInitV + j].depth)
+                level = vValues[i * numOfInitV + j].depth;
+        }
+    }
+    if(level == BFS_UNREACHED) return vCount * numOfInitV;
+
+    int wordCount = (vCount + 63) / 64;
+    this->frontier.resize(wordCount);
+    this->visited.resize(wordCount);
+
+    for(int j = 0; j < numOfInitV; j++)
+    {
+        //Bitmaps & direction heuristic parameters of this initV
+        std::fill(this->frontier.begin(), this->frontier.end(), 0);
+        std::fill(this->visited.begin(), this->visited.end(), 0);
+
+        int frontierCount = 0;
+        long long frontierEdgeCount = 0, unvisitedEdgeCount = 0;
+
+        for(int i = 0; i < vCount; i++)
+        {
+            int depth = vValues[i * numOfInitV + j].depth;
+            if(depth == BFS_UNREACHED)
+                unvisitedEdgeCount += index.inOffset[i + 1] - index.inOffset[i];
+            else
+            {
+                this->visited[i >> 6] |= 1ULL << (i & 63);
+                if(depth == level && vSet[i].isActive)
+                {
+                    this->frontier[i >> 6] |= 1ULL << (i & 63);
+                    frontierCount++;
+                    frontierEdgeCount += index.outOffset[i + 1] - index.outOffset[i];
+                }
+            }
+        }
+
+        if(frontierCount == 0) continue;
+
+        if(frontierEdgeCount > unvisitedEdgeCount / BFS_ALPHA && frontierCount > vCount / BFS_BETA)
+        {
+            //Bottom-up: every unvisited vertex looks for a parent in the frontier and stops at the first one
+            this->bottomUpCount++;
+
+            for(int w = 0; w < wordCount; w++)
+            {
+                uint64_t unvisited = ~this->visited[w];
+                while(unvisited)
+                {
+                    int i = (w << 6) + __builtin_ctzll(unvisited);
+                    unvisited &= unvisited - 1;
+                    if(i >= vCount) break;
+
+                    for(int k = index.inOffset[i]; k < index.inOffset[i + 1]; k++)
+                    {
+                        int src = index.inSrc[k];
+                        if(this->frontier[src >> 6] & (1ULL << (src & 63)))
+                        {
+                            mValues[i * numOfInitV + j] = (MessageValueType)src;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            //Top-down: frontier vertices are visited in ascending order, so the first parent found is the smallest
+            this->topDownCount++;
+
+            for(int w = 0; w < wordCount; w++)
+            {
+                uint64_t bits = this->frontier[w];
+                while(bits)
+                {
+                    int i = (w << 6) + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+
+                    for(int k = index.outOffset[i]; k < index.outOffset[i + 1]; k++)
+                    {
+                        int dst = index.outDst[k];
+                        if(this->visited[dst >> 6] & (1ULL << (dst & 63))) continue;
+                        this->visited[dst >> 6] |= 1ULL << (dst & 63);
+                        mValues[dst * numOfInitV + j] = (MessageValueType)i;
+                    }
+                }
+            }
+        }
+    }
+
+    return vCount * numOfInitV;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BFS<VertexValueType, MessageValueType>::Init(int vCount, int eCount, int numOfInitV)
+{
+    this->numOfInitV = numOfInitV;
+
+    //Memory parameter init
+    this->totalVValuesCount = vCount * numOfInitV;
+    this->totalMValuesCount = vCount * numOfInitV;
+
+    this->topDownCount = 0;
+    this->bottomUpCount = 0;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BFS<VertexValueType, MessageValueType>::GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList)
+{
+    int numOfInitV_init = initVList.size();
+
+    //v Init
+    for(int i = 0; i < numOfInitV_init; i++)
+        g.vList.at(initVList.at(i)).initVIndex = i;
+    for(auto &v : g.vList)
+    {
+        if(v.initVIndex != INVALID_INITV_INDEX)
+        {
+            activeVertices.insert(v.vertexID);
+            v.isActive = true;
+        }
+        else v.isActive = false;
+    }
+
+    //vValues init
+    //An initV is its own parent at depth 0
+    g.verticesValue.assign(g.vCount * numOfInitV_init, VertexValueType());
+    for(int initID : initVList)
+        g.verticesValue.at(initID * numOfInitV_init + g.vList.at(initID).initVIndex) = VertexValueType(initID, 0);
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BFS<VertexValueType, MessageValueType>::Deploy(int vCount, int eCount, int numOfInitV)
+{
+
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BFS<VertexValueType, MessageValueType>::Free()
+{
+    this->edgeIndexSet.clear();
+    this->frontier.clear();
+    this->visited.clear();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BFS<VertexValueType, MessageValueType>::MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                const std::vector<int> &initVList)
+{
+    //Init
+    activeVertices.clear();
+    for(auto &v : g.vList) v.isActive = false;
+
+    //Merge graphs
+    for(const auto &subG : subGSet)
+    {
+        //vSet merge
+        for(int i = 0; i < subG.vCount; i++)
+            g.vList.at(i).isActive |= subG.vList.at(i).isActive;
+
+        //vValues merge
+        //Pairs reached in this superstep have the same depth in every subG, and the smallest parent is kept
+        for(int i = 0; i < subG.verticesValue.size(); i++)
+        {
+            const auto &subV = subG.verticesValue.at(i);
+            auto &v = g.verticesValue.at(i);
+            if(subV.depth == BFS_UNREACHED) continue;
+            if(v.depth == BFS_UNREACHED || (v.depth == subV.depth && v.parent > subV.parent))
+                v = subV;
+        }
+    }
+
+    //Merge active vertices set
+    for(const auto &AVs : activeVerticeSet)
+    {
+        for(auto av : AVs)
+            activeVertices.insert(av);
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+const BFSEdgeIndex &BFS<VertexValueType, MessageValueType>::getEdgeIndex(int vCount, int eCount, const Edge *eSet)
+{
+    auto &index = this->edgeIndexSet[eSet];
+    if(index.eCount == eCount && index.outOffset.size() == vCount + 1) return index;
+
+    index.eCount = eCount;
+
+    //Counting sort of edges by src
+    index.outOffset.assign(vCount + 1, 0);
+    for(int i = 0; i < eCount; i++) index.outOffset.at(eSet[i].src + 1)++;
+    for(int i = 0; i < vCount; i++) index.outOffset.at(i + 1) += index.outOffset.at(i);
+
+    auto cursor = std::vector<int>(index.outOffset.begin(), index.outOffset.end() - 1);
+    index.outDst.resize(eCount);
+    for(int i = 0; i < eCount; i++) index.outDst.at(cursor.at(eSet[i].src)++) = eSet[i].dst;
+
+    //Counting sort of out-edges by dst, which keeps in-edges of every vertex ordered by src
+    index.inOffset.assign(vCount + 1, 0);
+    for(int i = 0; i < eCount; i++) index.inOffset.at(eSet[i].dst + 1)++;
+    for(int i = 0; i < vCount; i++) index.inOffset.at(i + 1) += index.inOffset.at(i);
+
+    cursor.assign(index.inOffset.begin(), index.inOffset.end() - 1);
+    index.inSrc.resize(eCount);
+    for(int i = 0; i < vCount; i++)
+    {
+        for(int k = index.outOffset.at(i); k < index.outOffset.at(i + 1); k++)
+            index.inSrc.at(cursor.at(index.outDst.at(k))++) = i;
+    }
+
+    return index;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BFS<VertexValueType, MessageValueType>::ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices)
+{
+    auto mMergedSet = MessageSet<MessageValueType>();
+
+    mMergedSet.mSet.clear();
+    MSGGenMerge(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "MGenMerge:" << clock() << std::endl;
+    //Test end
+
+    activeVertices.clear();
+    MSGApply(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "Apply:" << clock() << std::endl;
+    //Test end
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BFS<VertexValueType, MessageValueType>::Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    while(activeVertices.size() > 0)
+        ApplyStep(g, initVList, activeVertices);
+
+    Free();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BFS<VertexValueType, MessageValueType>::ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    //Edges never change, so subgraphs are divided only once and keep their edge indexes
+    auto subGraphSet = this->DivideGraphByEdge(g, partitionCount);
+
+    std::vector<std::set<int>> AVSet = std::vector<std::set<int>>();
+    for(int i = 0; i < partitionCount; i++) AVSet.push_back(std::set<int>());
+
+    int iterCount = 0;
+
+    while(activeVertices.size() > 0)
+    {
+        //Test
+        std::cout << ++iterCount << ":" << clock() << std::endl;
+        //Test end
+
+        for(int i = 0; i < partitionCount; i++)
+        {
+            auto &subG = subGraphSet.at(i);
+            subG.verticesValue = g.verticesValue;
+            for(int j = 0; j < g.vCount; j++) subG.vList.at(j).isActive = g.vList.at(j).isActive;
+            AVSet.at(i) = activeVertices;
+        }
+
+        for(int i = 0; i < partitionCount; i++)
+            ApplyStep(subGraphSet.at(i), initVList, AVSet.at(i));
+
+        MergeGraph(g, subGraphSet, activeVertices, AVSet, initVList);
+
+        //Test
+        std::cout << "GMerge:" << clock() << std::endl;
+        //Test end
+    }
+
+    Free();
+
+    //Test
+    std::cout << "end" << ":" << clock() << std::endl;
+    //Test end
+}
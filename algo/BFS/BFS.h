@@ -0,0 +1,101 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_BFS_H
+#define GRAPH_ALGO_BFS_H
+
+#include "../../core/GraphUtil.h"
+
+#include <type_traits>
+#include <cstdint>
+
+#define BFS_UNREACHED -1
+
+//Switch to bottom-up when edges to check from frontier are more than 1 / BFS_ALPHA of edges to check from unvisited vertices
+//and frontier is larger than 1 / BFS_BETA of vertices (Beamer et al.)
+#define BFS_ALPHA 14
+#define BFS_BETA 24
+
+//BFS value class definition
+//One value for each (vertex, initV) pair, ordered like BellmanFord: vValues[vid * numOfInitV + initVIndex]
+class BFSValue
+{
+public:
+    BFSValue() : BFSValue(BFS_UNREACHED, BFS_UNREACHED)
+    {
+
+    }
+
+    BFSValue(int parent, int depth)
+    {
+        this->parent = parent;
+        this->depth = depth;
+    }
+
+    int parent;
+    int depth;
+};
+
+static_assert(std::is_trivially_copyable<BFSValue>::value, "BFSValue should be able to be copied into shared memory directly");
+
+//Out-edge & in-edge index (CSR) of an edge set
+//In-edges of every vertex are ordered by src
+class BFSEdgeIndex
+{
+public:
+    BFSEdgeIndex();
+
+    int eCount;
+    std::vector<int> outOffset;
+    std::vector<int> outDst;
+    std::vector<int> inOffset;
+    std::vector<int> inSrc;
+};
+
+template <typename VertexValueType, typename MessageValueType>
+class BFS : public GraphUtil<VertexValueType, MessageValueType>
+{
+public:
+    BFS();
+
+    int MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet) override;
+    int MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet) override;
+
+    //mValues[vid * numOfInitV + initVIndex] is the smallest parent found for an unreached pair, or INVALID_MASSAGE
+    int MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues) override;
+    int MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues) override;
+
+    void MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                    std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                    const std::vector<int> &initVList) override;
+
+    void Init(int vCount, int eCount, int numOfInitV) override;
+    void GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList) override;
+    void Deploy(int vCount, int eCount, int numOfInitV) override;
+    void Free() override;
+
+    void ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices);
+    void Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList);
+
+    void ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount);
+
+    //Count of levels expanded top-down / bottom-up (for each initV) since Init
+    int topDownCount;
+    int bottomUpCount;
+
+protected:
+    int numOfInitV;
+
+    //Edge indexes of edge sets used by MSGGenMerge_array, built at the first use of each edge set
+    std::map<const Edge *, BFSEdgeIndex> edgeIndexSet;
+    //Bitmaps of one initV reused by MSGGenMerge_array
+    std::vector<uint64_t> frontier;
+    std::vector<uint64_t> visited;
+
+    const BFSEdgeIndex &getEdgeIndex(int vCount, int eCount, const Edge *eSet);
+};
+
+#endif //GRAPH_ALGO_BFS_H
@@ -0,0 +1,14 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "BFS.cpp"
+
+//BFSValue is defined in algo_BFS, so the core templates are instantiated here
+#include "../../core/Graph.cpp"
+#include "../../core/GraphUtil.cpp"
+
+template class Graph<BFSValue>;
+template class GraphUtil<BFSValue, int>;
+
+template class BFS<BFSValue, int>;
@@ -6,10 +6,13 @@
 
 #include <iostream>
 #include <ctime>
+#include <deque>
 
 template <typename VertexValueType, typename MessageValueType>
 BellmanFord<VertexValueType, MessageValueType>::BellmanFord()
 {
+    this->incrementalGraph = nullptr;
+    this->incrementalECount = 0;
 }
 
 template <typename VertexValueType, typename MessageValueType>
@@ -106,14 +109,43 @@ int BellmanFord<VertexValueType, MessageValueType>::MSGGenMerge_array(int vCount
 {
     for(int i = 0; i < vCount * numOfInitV; i++) mValues[i] = (MessageValueType)INVALID_MASSAGE;
 
+    auto &propagated = this->propagatedValueSet[eSet];
+    if(propagated.size() != vCount * numOfInitV) propagated.assign(vCount * numOfInitV, (VertexValueType)(INT32_MAX >> 1));
+
+    //Lane mask build
+    int wordCount = (numOfInitV + 63) >> 6;
+    this->laneMask.assign(vCount * wordCount, 0);
+    for(int i = 0; i < vCount; i++)
+    {
+        if(!vSet[i].isActive) continue;
+
+        for(int j = 0; j < numOfInitV; j++)
+        {
+            //Values only decrease within a run, and propagated values are dropped before a new one (see ResetRunState)
+            if(vValues[i * numOfInitV + j] != propagated[i * numOfInitV + j])
+            {
+                this->laneMask[i * wordCount + (j >> 6)] |= 1ULL << (j & 63);
+                propagated[i * numOfInitV + j] = vValues[i * numOfInitV + j];
+            }
+        }
+    }
+
     for(int i = 0; i < eCount; i++)
     {
         if(vSet[eSet[i].src].isActive)
         {
-            for(int j = 0; j < numOfInitV; j++)
+            //Only changed lanes of src are relaxed
+            for(int k = 0; k < wordCount; k++)
             {
-                if(mValues[eSet[i].dst * numOfInitV + j] > (MessageValueType)vValues[eSet[i].src * numOfInitV + j] + eSet[i].weight)
-                    mValues[eSet[i].dst * numOfInitV + j] = (MessageValueType)vValues[eSet[i].src * numOfInitV + j] + eSet[i].weight;
+                auto bits = this->laneMask[eSet[i].src * wordCount + k];
+                while(bits)
+                {
+                    int j = (k << 6) + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+
+                    if(mValues[eSet[i].dst * numOfInitV + j] > (MessageValueType)vValues[eSet[i].src * numOfInitV + j] + eSet[i].weight)
+                        mValues[eSet[i].dst * numOfInitV + j] = (MessageValueType)vValues[eSet[i].src * numOfInitV + j] + eSet[i].weight;
+                }
             }
         }
     }
@@ -121,6 +153,62 @@ int BellmanFord<VertexValueType, MessageValueType>::MSGGenMerge_array(int vCount
     return vCount * numOfInitV;
 }
 
+template <typename VertexValueType, typename MessageValueType>
+bool BellmanFord<VertexValueType, MessageValueType>::isMSGMergeable()
+{
+    return true;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BellmanFord<VertexValueType, MessageValueType>::MSGMerge_array(int vCount, int numOfInitV, MessageValueType *mValues, const MessageValueType *mValuesOther)
+{
+    for(int i = 0; i < vCount * numOfInitV; i++)
+    {
+        if(mValues[i] > mValuesOther[i])
+            mValues[i] = mValuesOther[i];
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+bool BellmanFord<VertexValueType, MessageValueType>::isApplyVertexLocal()
+{
+    return true;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+bool BellmanFord<VertexValueType, MessageValueType>::isQueryable()
+{
+    return true;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BellmanFord<VertexValueType, MessageValueType>::GraphInit_array(int vCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues)
+{
+    for(int i = 0; i < vCount; i++)
+    {
+        vSet[i].isActive = false;
+        vSet[i].initVIndex = INVALID_INITV_INDEX;
+    }
+
+    for(int i = 0; i < vCount * numOfInitV; i++) vValues[i] = (VertexValueType)(INT32_MAX >> 1);
+
+    for(int j = 0; j < numOfInitV; j++)
+    {
+        int initID = initVSet[j];
+        if(initID < 0) continue;
+
+        vSet[initID].initVIndex = j;
+        vSet[initID].isActive = true;
+        vValues[initID * numOfInitV + j] = (VertexValueType)0;
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void BellmanFord<VertexValueType, MessageValueType>::ResetRunState()
+{
+    this->propagatedValueSet.clear();
+}
+
 template <typename VertexValueType, typename MessageValueType>
 void BellmanFord<VertexValueType, MessageValueType>::Init(int vCount, int eCount, int numOfInitV)
 {
@@ -129,6 +217,7 @@ void BellmanFord<VertexValueType, MessageValueType>::Init(int vCount, int eCount
     //Memory parameter init
     this->totalVValuesCount = vCount * numOfInitV;
     this->totalMValuesCount = vCount * numOfInitV;
+    this->propagatedValueSet.clear();
 }
 
 template <typename VertexValueType, typename MessageValueType>
@@ -166,7 +255,8 @@ void BellmanFord<VertexValueType, MessageValueType>::Deploy(int vCount, int eCou
 template <typename VertexValueType, typename MessageValueType>
 void BellmanFord<VertexValueType, MessageValueType>::Free()
 {
-
+    this->propagatedValueSet.clear();
+    this->laneMask.clear();
 }
 
 template <typename VertexValueType, typename MessageValueType>
@@ -261,6 +351,9 @@ void BellmanFord<VertexValueType, MessageValueType>::ApplyD(Graph<VertexValueTyp
 
     Deploy(g.vCount, g.eCount, initVList.size());
 
+    //Subgraphs are divided only once, so that every edge set keeps its propagated lane values
+    auto subGraphSet = this->DivideGraphByEdge(g, partitionCount);
+
     int iterCount = 0;
 
     while(activeVertices.size() > 0)
@@ -269,10 +362,11 @@ void BellmanFord<VertexValueType, MessageValueType>::ApplyD(Graph<VertexValueTyp
         std::cout << ++iterCount << ":" << clock() << std::endl;
         //Test end
 
-        auto subGraphSet = this->DivideGraphByEdge(g, partitionCount);
-
         for(int i = 0; i < partitionCount; i++)
         {
+            auto &subG = subGraphSet.at(i);
+            subG.verticesValue = g.verticesValue;
+            for(int j = 0; j < g.vCount; j++) subG.vList.at(j).isActive = g.vList.at(j).isActive;
             AVSet.at(i).clear();
             AVSet.at(i) = activeVertices;
         }
@@ -297,3 +391,78 @@ void BellmanFord<VertexValueType, MessageValueType>::ApplyD(Graph<VertexValueTyp
     std::cout << "end" << ":" << clock() << std::endl;
     //Test end
 }
+
+template <typename VertexValueType, typename MessageValueType>
+void BellmanFord<VertexValueType, MessageValueType>::ApplyIncremental(Graph<VertexValueType> &g, const std::vector<int> &initVList, const std::vector<Edge> &newEdges)
+{
+    int numOfInitV = initVList.size();
+
+    //Without a previous result, distances are computed from scratch
+    if(g.verticesValue.size() != g.vCount * numOfInitV)
+    {
+        for(const auto &e : newEdges) g.insertEdge(e.src, e.dst, e.weight);
+        this->Apply(g, initVList);
+        return;
+    }
+
+    //Out-edge index sync
+    if(this->incrementalGraph != &g || this->incrementalECount != g.eCount || this->incrementalOutEdges.size() != g.vCount)
+    {
+        this->incrementalGraph = &g;
+        this->incrementalECount = 0;
+        this->incrementalOutEdges.assign(g.vCount, std::vector<int>());
+    }
+    for(const auto &e : newEdges) g.insertEdge(e.src, e.dst, e.weight);
+    for(; this->incrementalECount < g.eCount; this->incrementalECount++)
+        this->incrementalOutEdges.at(g.eList.at(this->incrementalECount).src).emplace_back(this->incrementalECount);
+
+    //Label correcting from dst of new edges
+    //Every queued vertex keeps a mask of its lanes improved since it was queued, and only those lanes are relaxed along its out-edges
+    int wordCount = (numOfInitV + 63) >> 6;
+    auto pendingMask = std::vector<uint64_t>(g.vCount * wordCount, 0);
+    auto queue = std::deque<int>();
+
+    auto relax = [&](const Edge &e, int j)
+    {
+        auto &srcValue = g.verticesValue.at(e.src * numOfInitV + j);
+        auto &dstValue = g.verticesValue.at(e.dst * numOfInitV + j);
+        if(srcValue >= (VertexValueType)(INT32_MAX >> 1) || dstValue <= srcValue + e.weight) return;
+
+        dstValue = srcValue + e.weight;
+        bool isQueued = false;
+        for(int k = 0; k < wordCount; k++) isQueued |= pendingMask.at(e.dst * wordCount + k) != 0;
+        pendingMask.at(e.dst * wordCount + (j >> 6)) |= 1ULL << (j & 63);
+        if(!isQueued) queue.emplace_back(e.dst);
+    };
+
+    for(int i = g.eCount - (int)newEdges.size(); i < g.eCount; i++)
+    {
+        for(int j = 0; j < numOfInitV; j++)
+            relax(g.eList.at(i), j);
+    }
+
+    while(!queue.empty())
+    {
+        int v = queue.front();
+        queue.pop_front();
+
+        auto mask = std::vector<uint64_t>(pendingMask.begin() + v * wordCount, pendingMask.begin() + (v + 1) * wordCount);
+        std::fill(pendingMask.begin() + v * wordCount, pendingMask.begin() + (v + 1) * wordCount, 0);
+
+        for(int eID : this->incrementalOutEdges.at(v))
+        {
+            for(int k = 0; k < wordCount; k++)
+            {
+                auto bits = mask.at(k);
+                while(bits)
+                {
+                    int j = (k << 6) + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    relax(g.eList.at(eID), j);
+                }
+            }
+        }
+    }
+
+    for(auto &v : g.vList) v.isActive = false;
+}
@@ -9,6 +9,8 @@
 
 #include "../../core/GraphUtil.h"
 
+#include <cstdint>
+
 template <typename VertexValueType, typename MessageValueType>
 class BellmanFord : public GraphUtil<VertexValueType, MessageValueType>
 {
@@ -22,6 +24,13 @@ public:
     int MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues) override;
     int MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues) override;
 
+    bool isMSGMergeable() override;
+    void MSGMerge_array(int vCount, int numOfInitV, MessageValueType *mValues, const MessageValueType *mValuesOther) override;
+    bool isApplyVertexLocal() override;
+    bool isQueryable() override;
+    void GraphInit_array(int vCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues) override;
+    void ResetRunState() override;
+
     void MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
                     std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
                     const std::vector<int> &initVList) override;
@@ -36,8 +45,25 @@ public:
 
     void ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount);
 
+    //Insert newEdges into g and update distances from the current verticesValue, which should be the result of Apply with the same initVList
+    //Only dst of new edges which are improved and their descendants are relaxed, and the result is the same as Apply on the new g
+    void ApplyIncremental(Graph<VertexValueType> &g, const std::vector<int> &initVList, const std::vector<Edge> &newEdges);
+
 protected:
     int numOfInitV;
+
+    //Values of every (vertex, initV) lane when they were last relaxed along each edge set
+    //A lane of an active vertex is relaxed again only if it has improved since then
+    //Kept for each edge set since improvements may come from other subgraphs (MergeGraph or the client), and dropped for a new run
+    std::map<const Edge *, std::vector<VertexValueType>> propagatedValueSet;
+    //Changed lanes of every active vertex in this superstep, one bit per initV
+    std::vector<uint64_t> laneMask;
+
+    //Out-edges (indexes in eList) of every vertex of the graph updated by ApplyIncremental
+    //Extended by every batch rather than rebuilt, as long as edges of the graph are only inserted by ApplyIncremental
+    const AbstractGraph *incrementalGraph;
+    int incrementalECount;
+    std::vector<std::vector<int>> incrementalOutEdges;
 };
 
 #endif //GRAPH_ALGO_BELLMANFORD_H
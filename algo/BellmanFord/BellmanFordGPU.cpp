@@ -76,6 +76,12 @@ BellmanFordGPU<VertexValueType, MessageValueType>::BellmanFordGPU()
 
 }
 
+template <typename VertexValueType, typename MessageValueType>
+bool BellmanFordGPU<VertexValueType, MessageValueType>::isMSGMergeable()
+{
+    return false;
+}
+
 template <typename VertexValueType, typename MessageValueType>
 void BellmanFordGPU<VertexValueType, MessageValueType>::Init(int vCount, int eCount, int numOfInitV)
 {
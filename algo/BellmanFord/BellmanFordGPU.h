@@ -24,6 +24,9 @@ public:
     int MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues) override;
     int MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues) override;
 
+    //Device memory is owned by one executor
+    bool isMSGMergeable() override;
+
 protected:
     int vertexLimit;
     int mPerMSGSet;
@@ -6,11 +6,19 @@
 
 #include <iostream>
 #include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+//Edges united by a thread at a time
+#define CC_CHUNK_SIZE 1024
 
 template <typename VertexValueType, typename MessageValueType>
 ConnectedComponent<VertexValueType, MessageValueType>::ConnectedComponent()
 {
-
+    this->threadCount = std::max(1u, std::thread::hardware_concurrency());
+    this->incrementalGraph = nullptr;
+    this->incrementalECount = 0;
 }
 
 template<typename VertexValueType, typename MessageValueType>
@@ -276,3 +284,91 @@ void ConnectedComponent<VertexValueType, MessageValueType>::ApplyD(Graph<VertexV
     std::cout << "end" << ":" << clock() << std::endl;
     //Test end
 }
+
+template <typename VertexValueType, typename MessageValueType>
+int ConnectedComponent<VertexValueType, MessageValueType>::find(int vid)
+{
+    //Path splitting: every vertex on the path is linked to its grandparent
+    while(true)
+    {
+        int p = __atomic_load_n(&this->parent[vid], __ATOMIC_RELAXED);
+        if(p == vid) return vid;
+
+        int gp = __atomic_load_n(&this->parent[p], __ATOMIC_RELAXED);
+        if(p != gp) __atomic_compare_exchange_n(&this->parent[vid], &p, gp, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+        vid = p;
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void ConnectedComponent<VertexValueType, MessageValueType>::unite(int src, int dst)
+{
+    //The larger root is linked to the smaller one, and it is retried if the larger one stops being a root meanwhile
+    while(true)
+    {
+        src = this->find(src);
+        dst = this->find(dst);
+        if(src == dst) return;
+        if(src < dst) std::swap(src, dst);
+
+        int expected = src;
+        if(__atomic_compare_exchange_n(&this->parent[src], &expected, dst, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) return;
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void ConnectedComponent<VertexValueType, MessageValueType>::uniteEdges(const Edge *eSet, int eCount)
+{
+    int threadCount = std::max(1, std::min(this->threadCount, eCount / CC_CHUNK_SIZE + 1));
+    std::atomic<int> next(0);
+
+    auto uniteChunks = [&]()
+    {
+        for(int begin = next.fetch_add(CC_CHUNK_SIZE); begin < eCount; begin = next.fetch_add(CC_CHUNK_SIZE))
+        {
+            for(int i = begin; i < std::min(begin + CC_CHUNK_SIZE, eCount); i++)
+                this->unite(eSet[i].src, eSet[i].dst);
+        }
+    };
+
+    auto threads = std::vector<std::thread>();
+    for(int t = 1; t < threadCount; t++) threads.emplace_back(uniteChunks);
+    uniteChunks();
+    for(auto &th : threads) th.join();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void ConnectedComponent<VertexValueType, MessageValueType>::ApplyIncremental(Graph<VertexValueType> &g, const std::vector<Edge> &newEdges)
+{
+    //Union-find state sync
+    //Edges of g which are not absorbed yet (all of them at the first call) are united together with newEdges
+    if(this->incrementalGraph != &g || this->parent.size() != g.vCount || this->incrementalECount > g.eCount)
+    {
+        this->incrementalGraph = &g;
+        this->incrementalECount = 0;
+        this->parent.resize(g.vCount);
+        for(int i = 0; i < g.vCount; i++) this->parent.at(i) = i;
+    }
+
+    for(const auto &e : newEdges) g.insertEdge(e.src, e.dst, e.weight);
+
+    this->uniteEdges(g.eList.data() + this->incrementalECount, g.eCount - this->incrementalECount);
+    this->incrementalECount = g.eCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int ConnectedComponent<VertexValueType, MessageValueType>::componentOf(int vid)
+{
+    return this->find(vid);
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void ConnectedComponent<VertexValueType, MessageValueType>::ExportComponents(Graph<VertexValueType> &g)
+{
+    g.verticesValue.resize(g.vCount);
+    for(int i = 0; i < g.vCount; i++)
+    {
+        g.verticesValue.at(i) = (VertexValueType)this->find(i);
+        g.vList.at(i).isActive = false;
+    }
+}
@@ -36,8 +36,29 @@ public:
 
     void ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount);
 
+    //Insert newEdges into g and absorb them into the union-find state of g, which is built from edges of g at the first call
+    //Components are taken as undirected, and labeled by their smallest vertexIDs (the same as Apply on graphs with edges of both directions)
+    void ApplyIncremental(Graph<VertexValueType> &g, const std::vector<Edge> &newEdges);
+    //Label of the component of vid in the union-find state
+    int componentOf(int vid);
+    //Write labels of all vertices into verticesValue of g
+    void ExportComponents(Graph<VertexValueType> &g);
+
+    //Threads used by ApplyIncremental
+    int threadCount;
+
 protected:
     int numOfInitV;
+
+    //Union-find state, where every root is the smallest vertexID of its component
+    //parent is accessed atomically, so that edges can be united by threads without locks
+    const AbstractGraph *incrementalGraph;
+    int incrementalECount;
+    std::vector<int> parent;
+
+    int find(int vid);
+    void unite(int src, int dst);
+    void uniteEdges(const Edge *eSet, int eCount);
 };
 
 #endif //GRAPH_ALGO_CONNECTEDCOMPONENT_H
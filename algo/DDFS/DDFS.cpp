@@ -6,12 +6,12 @@
 
 #include <iostream>
 #include <ctime>
-#include <queue>
+#include <algorithm>
 
 template <typename VertexValueType, typename MessageValueType>
 DDFS<VertexValueType, MessageValueType>::DDFS()
 {
-
+    this->arena = nullptr;
 }
 
 template <typename VertexValueType, typename MessageValueType>
@@ -53,17 +53,14 @@ int DDFS<VertexValueType, MessageValueType>::MSGGenMerge(const Graph<VertexValue
     mSet.mSet.clear();
     mSet.mSet.reserve(2 * g.eCount);
 
-    auto tmpMSGSet = std::vector<MessageValueType>(2 * g.eCount, MessageValueType());
+    //Broadcast msgs are sent along vStates (at most 2 * eCount) and every vertex sends at most one token
+    auto tmpMSGSet = std::vector<MessageValueType>(2 * g.eCount + g.vCount, MessageValueType());
 
     //array form computation
-    this->MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], &g.eList[0], this->numOfInitV, &initVSet[0], &g.verticesValue[0], &tmpMSGSet[0]);
+    int msgCount = this->MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], &g.eList[0], this->numOfInitV, &initVSet[0], &g.verticesValue[0], &tmpMSGSet[0]);
 
     //Package msgs
-    for(const auto &m : tmpMSGSet)
-    {
-        if(m.src != -1) mSet.insertMsg(m);
-        else break;
-    }
+    for(int i = 0; i < msgCount; i++) mSet.insertMsg(tmpMSGSet.at(i));
 
     return mSet.mSet.size();
 }
@@ -74,77 +71,67 @@ int DDFS<VertexValueType, MessageValueType>::MSGApply_array(int vCount, int eCou
 {
     int avCount = 0;
 
-    //Reset vertex activity
-    for(int i = 0; i < vCount; i++)
-        vSet[i].isActive = false;
-
-    //Reset opbit & vNextMSGTo
+    //Reset vertex activity, opbit & vNextMSGTo
+    //Only vertices which sent msgs in last superstep have them set
     for(int i = 0; i < vCount; i++)
     {
-        vValues[i].opbit = 0;
-        vValues[i].vNextMSGTo = -1;
+        if(vSet[i].isActive)
+        {
+            vSet[i].isActive = false;
+            vValues[i].opbit = 0;
+            vValues[i].vNextMSGTo = -1;
+            this->logVertex(i);
+        }
     }
 
+    //Vertices which got the token in this superstep
+    auto tokenHolders = std::vector<int>();
+
     //Check each msgs
     //msgs are sent from edges
     //eCount here is the account of edges which contains messages rather than the account of g's edges
     //(eCount = mValues.size)
+    //msg visited should be checked before msg token, or the token may be sent to a vertex which has just been discovered
     for(int i = 0; i < eCount; i++)
     {
-        //msg token check
-        if(mValues[i].msgbit & MSG_TOKEN)
+        if(mValues[i].msgbit & MSG_VISITED)
         {
-            if(vValues[mValues[i].dst].state == STATE_IDLE)
+            auto &vV = vValues[mValues[i].dst];
+            int index = this->findVState(vV, mValues[i].src);
+            if(index == -1) continue;
+
+            char mark = this->arena->vStateList[vV.vStateOffset + index].second;
+            if(mark == MARK_UNVISITED)
+                this->setVState(vV, index, MARK_VISITED);
+            else if(mark == MARK_SON)
             {
-                //Mark j as i's father
-                //There should be some approach more efficient
-                for(auto &vState : vValues[mValues[i].dst].vStateList)
-                {
-                    if(vState.first == mValues[i].src)
-                    {
-                        vState.second = MARK_PARENT;
-                        break;
-                    }
-                }
-
-                vValues[mValues[i].dst].state = STATE_DISCOVERED;
-                vValues[mValues[i].dst].vNextMSGTo = this->search(mValues[i].dst, numOfInitV, initVSet, vSet, vValues, avCount);
-
-                //prepare to broadcast msg "visited" to other vertices
-                vValues[mValues[i].dst].opbit |= OP_BROADCAST;
-
-                //Vertex which will send msg will be activated
-                if(!vSet[mValues[i].dst].isActive)
-                {
-                    vSet[mValues[i].dst].isActive = true;
-                    avCount++;
-                }
-            }
-        }
-        //msg visited check
-        else if(mValues[i].msgbit & MSG_VISITED)
-        {
-            //There should be some approach more efficient
-            for(auto &vState : vValues[mValues[i].dst].vStateList)
-            {
-                if(vState.first == mValues[i].src)
-                {
-                    if(vState.second == MARK_UNVISITED)
-                    {
-                        vState.second = MARK_VISITED;
-                        vValues[mValues[i].dst].vNextMSGTo = -1;
-                    }
-                    else if(vState.second == MARK_SON)
-                    {
-                        vState.second = MARK_VISITED;
-                        vValues[mValues[i].dst].vNextMSGTo = this->search(mValues[i].dst, numOfInitV, initVSet, vSet, vValues, avCount);
-                    }
-                }
+                this->setVState(vV, index, MARK_VISITED);
+                vV.vNextMSGTo = this->search(mValues[i].dst, numOfInitV, initVSet, vSet, vValues, avCount);
+                tokenHolders.emplace_back(mValues[i].dst);
             }
         }
-        else;
     }
 
+    //msg token check
+    //Tokens of lower roots are received first, so they win idle vertices wanted by several tokens
+    auto tokenMSGs = std::vector<int>();
+    for(int i = 0; i < eCount; i++)
+    {
+        if(mValues[i].msgbit & MSG_TOKEN)
+            tokenMSGs.emplace_back(i);
+    }
+    std::stable_sort(tokenMSGs.begin(), tokenMSGs.end(),
+                     [&](int a, int b){return vValues[mValues[a].src].vRoot < vValues[mValues[b].src].vRoot;});
+
+    for(int i : tokenMSGs)
+    {
+        if(this->receiveToken(mValues[i].src, mValues[i].dst, numOfInitV, initVSet, vSet, vValues, avCount, tokenHolders))
+            tokenHolders.emplace_back(mValues[i].dst);
+    }
+
+    //DFS goes on without superstep boundary until the tokens leave current (sub)graph
+    this->passTokenLocally(numOfInitV, initVSet, vSet, vValues, avCount, tokenHolders);
+
     return avCount;
 }
 
@@ -162,8 +149,9 @@ DDFS<VertexValueType, MessageValueType>::MSGGenMerge_array(int vCount, int eCoun
             //Check if needed to generate broadcast msg
             if (vValues[i].opbit & OP_BROADCAST)
             {
-                for (const auto &vState : vValues[i].vStateList)
+                for (int j = vValues[i].vStateOffset; j < vValues[i].vStateOffset + vValues[i].relatedVCount; j++)
                 {
+                    const auto &vState = this->arena->vStateList[j];
                     if (vState.second == MARK_UNVISITED || vState.second == MARK_VISITED)
                     {
                         mValues[msgCount].src = i;
@@ -177,7 +165,8 @@ DDFS<VertexValueType, MessageValueType>::MSGGenMerge_array(int vCount, int eCoun
                 }
             }
             //Check if needed to generate search msg
-            if (vValues[i].opbit & OP_MSG_FROM_SEARCH)
+            //Only the (sub)graph which owns the vState of vNextMSGTo sends the token
+            if ((vValues[i].opbit & OP_MSG_FROM_SEARCH) && this->findVState(vValues[i], vValues[i].vNextMSGTo) != -1)
             {
                 mValues[msgCount].src = i;
                 mValues[msgCount].dst = vValues[i].vNextMSGTo;
@@ -199,73 +188,144 @@ void DDFS<VertexValueType, MessageValueType>::MergeGraph(Graph<VertexValueType>
                                        const std::vector<std::set<int>> &activeVerticeSet,
                                        const std::vector<int> &initVList)
 {
-    //Reset global vValues
-    for(auto &vV : g.verticesValue)
+    int subGCount = subGSet.size();
+
+    //Only vertices & vStates logged by subgraphs are changed since last SyncSubGraph
+    //Reset global vValues of changed vertices
+    for(int k = 0; k < subGCount; k++)
     {
-        //state reset
-        vV.state = STATE_IDLE;
-        //vNextMSGTo reset
-        vV.vNextMSGTo = -1;
-        //opbit reset
-        vV.opbit = (char)0;
-
-        //Didn't be implemented yet
-        //startTime reset
-        //endTime reset
+        for(int v : this->subGArena.at(k).changedVertices)
+        {
+            auto &vV = g.verticesValue.at(v);
+            //vNextMSGTo reset
+            vV.vNextMSGTo = -1;
+            //opbit reset
+            vV.opbit = (char)0;
+        }
     }
 
+    //Vertices discovered by tokens of different roots in different subgraphs with the parents they lost
+    auto lostParents = std::vector<std::pair<int, int>>();
+
     //Merge subGs parameters
-    for(const auto &subG : subGSet)
+    for(int k = 0; k < subGCount; k++)
     {
-        for(int i = 0; i < g.vCount; i++)
+        const auto &subArena = this->subGArena.at(k);
+        for(int v : subArena.changedVertices)
         {
-            const auto &vVSub = subG.verticesValue.at(i);
-            auto &vV = g.verticesValue.at(i);
+            const auto &vVSub = subGSet.at(k).verticesValue.at(v);
+            auto &vV = g.verticesValue.at(v);
             //state merge
             vV.state |= vVSub.state;
+            //parent & root merge
+            //Vertex discovered in this superstep belongs to the tree of the lowest root
+            if(vVSub.vRoot != -1 && vVSub.vRoot != vV.vRoot)
+            {
+                if(vV.vRoot == -1 || vVSub.vRoot < vV.vRoot)
+                {
+                    if(vV.vRoot != -1) lostParents.emplace_back(v, vV.vParent);
+                    vV.vRoot = vVSub.vRoot;
+                    vV.vParent = vVSub.vParent;
+                }
+                else lostParents.emplace_back(v, vVSub.vParent);
+            }
             //vNextMSGTo merge
-            if(!(vV.opbit & OP_MSG_FROM_SEARCH) && (vVSub.opbit & OP_MSG_FROM_SEARCH)) vV.vNextMSGTo = vVSub.vNextMSGTo;
-            else if(!(vV.opbit & OP_MSG_DOWNWARD) && (vVSub.opbit & OP_MSG_DOWNWARD)) vV.vNextMSGTo = vVSub.vNextMSGTo;
-            else;
+            if(vVSub.opbit & OP_MSG_FROM_SEARCH) vV.vNextMSGTo = vVSub.vNextMSGTo;
             //opbit merge
             vV.opbit |= vVSub.opbit;
+            //Cursor of boundary vertex only moves on global arena
+            if(!subArena.isBoundary.at(v)) vV.vStateCursor = vVSub.vStateCursor;
 
             //Didn't be implemented yet
             //startTime merge
             //endTime merge
+
+            this->globalArena.changedVertices.emplace_back(v);
         }
-    }
 
-    //Merge subG vStateList
-    int subGCount = subGSet.size();
-    int *subGIndex = new int [subGCount];
-    for(int i = 0; i < subGCount; i++) subGIndex[i] = 0;
+        //Merge subG vStates
+        for(int index : subArena.changedVStates)
+            this->globalArena.vStateList.at(subArena.globalIndex.at(index)).second = subArena.vStateList.at(index).second;
+    }
 
-    for(int i = 0; i < g.vCount; i++)
+    //vState marked as parent by the losing tree is just a visited one
+    //Vertex will broadcast msg "visited" through it, so that the losing tree searches again
+    this->arena = &this->globalArena;
+    for(const auto &lost : lostParents)
     {
-        auto &vV = g.verticesValue.at(i);
-        for(int j = 0; j < vV.relatedVCount; j++)
-        {
-            for(int k = 0; k < subGCount; k++)
-            {
-                if(vV.vStateList.at(j).first == subGSet.at(k).verticesValue.at(i).vStateList.at(subGIndex[k]).first)
-                {
-                    vV.vStateList.at(j).second = subGSet.at(k).verticesValue.at(i).vStateList.at(subGIndex[k]).second;
-                    subGIndex[k]++;
-                    break;
-                }
-            }
-        }
+        const auto &vV = g.verticesValue.at(lost.first);
+        this->setVState(vV, this->findVState(vV, lost.second), MARK_VISITED);
     }
 
     //Merge activeVertices
+    for(int av : activeVertices) g.vList.at(av).isActive = false;
     activeVertices.clear();
 
     for(const auto &avs : activeVerticeSet)
     {
         for(const auto &av : avs)
+        {
             activeVertices.insert(av);
+            g.vList.at(av).isActive = true;
+        }
+    }
+
+    //Vertices whose vStates spread over subgraphs search on global arena
+    int avCount = 0;
+    int changedVCount = this->globalArena.changedVertices.size();
+    for(int i = 0; i < changedVCount; i++)
+    {
+        int v = this->globalArena.changedVertices.at(i);
+        auto &vV = g.verticesValue.at(v);
+        if(vV.opbit & OP_SEARCH_DEFERRED)
+        {
+            vV.opbit &= ~OP_SEARCH_DEFERRED;
+            vV.vNextMSGTo = this->search(v, this->numOfInitV, &initVList[0], &g.vList[0], &g.verticesValue[0], avCount);
+            if(g.vList.at(v).isActive) activeVertices.insert(v);
+        }
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void DDFS<VertexValueType, MessageValueType>::SyncSubGraph(const Graph<VertexValueType> &g, std::vector<Graph<VertexValueType>> &subGSet,
+                                                         const std::set<int> &activeVertices, std::vector<std::set<int>> &activeVerticeSet)
+{
+    int subGCount = subGSet.size();
+
+    for(int k = 0; k < subGCount; k++)
+    {
+        auto &subG = subGSet.at(k);
+
+        //Copy changed vertices except their vState ranges
+        for(int v : this->globalArena.changedVertices)
+        {
+            const auto &vV = g.verticesValue.at(v);
+            auto &vVSub = subG.verticesValue.at(v);
+            vVSub.state = vV.state;
+            vVSub.opbit = vV.opbit;
+            vVSub.vNextMSGTo = vV.vNextMSGTo;
+            vVSub.startTime = vV.startTime;
+            vVSub.endTime = vV.endTime;
+            vVSub.vParent = vV.vParent;
+            vVSub.vStateCursor = vV.vStateCursor;
+            vVSub.vRoot = vV.vRoot;
+        }
+
+        //Every subgraph works on the same active vertices
+        for(int av : activeVerticeSet.at(k)) subG.vList.at(av).isActive = false;
+        for(int av : activeVertices) subG.vList.at(av).isActive = true;
+        activeVerticeSet.at(k) = activeVertices;
+
+        this->subGArena.at(k).changedVertices.clear();
+        this->subGArena.at(k).changedVStates.clear();
     }
+
+    //Copy vStates changed on global arena into their owner subgraphs
+    for(int index : this->globalArena.changedVStates)
+        this->subGArena.at(this->vStateOwner.at(index)).vStateList.at(this->vStateOwnerIndex.at(index)).second = this->globalArena.vStateList.at(index).second;
+
+    this->globalArena.changedVertices.clear();
+    this->globalArena.changedVStates.clear();
 }
 
 template <typename VertexValueType, typename MessageValueType>
@@ -275,7 +335,7 @@ void DDFS<VertexValueType, MessageValueType>::Init(int vCount, int eCount, int n
 
     //Memory parameter init
     this->totalVValuesCount = vCount;
-    this->totalMValuesCount = eCount;
+    this->totalMValuesCount = 2 * eCount + vCount;
 }
 
 template <typename VertexValueType, typename MessageValueType>
@@ -286,53 +346,115 @@ void DDFS<VertexValueType, MessageValueType>::GraphInit(Graph<VertexValueType> &
 
     //Global init
     //Init graph parameters
-    for(int i = 0; i < g.vCount; i++) g.verticesValue.emplace_back(VertexValueType());
-    //Scan edges in graph and collect info
-    /*
-     * for edge (a, b):
-     *     add pair (b, MARK_UNVISITED) as (vid, mark) into a's vState priority queue ordered by vid
-     *     add pair (a, MARK_UNVISITED) as (vid, mark) into b's vState priority queue ordered by vid
-    */
-    auto pqVector = std::vector<std::priority_queue<std::pair<int, char>, std::vector<std::pair<int, char>>, cmp>>(g.vCount, std::priority_queue<std::pair<int, char>, std::vector<std::pair<int, char>>, cmp>());
-    for(const auto &e : g.eList)
+    g.verticesValue.assign(g.vCount, VertexValueType());
+
+    //Collect sorted vStates of every vertex into vState arena
+    this->globalArena = DFSStateArena();
+    this->buildVStateArena(g.vCount, g.eList, &g.verticesValue[0], this->globalArena.vStateList);
+    this->arena = &this->globalArena;
+
+    //initV init
+    //Every initV is the root of a DFS tree and has a token
+    for(int initV : initVList)
     {
-        pqVector.at(e.src).push(std::pair<int, char>(e.dst, MARK_UNVISITED));
-        pqVector.at(e.dst).push(std::pair<int, char>(e.src, MARK_UNVISITED));
+        auto &vV = g.verticesValue.at(initV);
+        vV.state = STATE_DISCOVERED;
+        vV.vRoot = initV;
     }
 
-    //For every vertex (for example i), pull sorted vState pairs from pq and push them into g.verticesValue.at(i).vStateList
-    //The order of verticesValue.vStateList in graph can be ensured
-    for(int i = 0; i < g.vCount; i++)
+    //Roots see each other as visited before searching
+    auto tokenHolders = std::vector<int>();
+    for(int initV : initVList)
+        this->broadcastLocally(initV, this->numOfInitV, &initVList[0], &g.vList[0], &g.verticesValue[0], avCount, tokenHolders);
+
+    for(int initV : initVList)
     {
-        while(!pqVector.at(i).empty())
-        {
-            g.verticesValue.at(i).vStateList.emplace_back(pqVector.at(i).top());
-            g.verticesValue.at(i).relatedVCount++;
-            pqVector.at(i).pop();
-        }
+        auto &vV = g.verticesValue.at(initV);
+        vV.vNextMSGTo = this->search(initV, this->numOfInitV, &initVList[0], &g.vList[0], &g.verticesValue[0], avCount);
+        if(g.vList.at(initV).isActive) activeVertices.insert(initV);
     }
+}
 
-    //initV init
-    int initV = initVList.at(0);
+template <typename VertexValueType, typename MessageValueType>
+void DDFS<VertexValueType, MessageValueType>::Deploy(int vCount, int eCount, int numOfInitV)
+{
 
-    g.vList.at(initV).isActive = true;
+}
 
-    auto &vV = g.verticesValue.at(initV);
-    vV.state = STATE_DISCOVERED;
-    this->search(initV, this->numOfInitV, &initVList[0], &g.vList[0], &g.verticesValue[0], avCount);
-    vV.opbit |= OP_BROADCAST;
+template <typename VertexValueType, typename MessageValueType>
+void DDFS<VertexValueType, MessageValueType>::Free()
+{
+    this->globalArena = DFSStateArena();
+    this->subGArena.clear();
+    this->vStateOwner.clear();
+    this->vStateOwnerIndex.clear();
+    this->arena = nullptr;
 }
 
 template <typename VertexValueType, typename MessageValueType>
-void DDFS<VertexValueType, MessageValueType>::Deploy(int vCount, int eCount, int numOfInitV)
+void DDFS<VertexValueType, MessageValueType>::buildVStateArena(int vCount, const std::vector<Edge> &eSet, VertexValueType *vValues, std::vector<std::pair<int, char>> &arena)
 {
+    //Count related vertices of every vertex
+    //Self loops never carry the token anywhere
+    auto offset = std::vector<int>(vCount + 1, 0);
+    for(const auto &e : eSet)
+    {
+        if(e.src == e.dst) continue;
+        offset.at(e.src + 1)++;
+        offset.at(e.dst + 1)++;
+    }
+    for(int i = 0; i < vCount; i++) offset.at(i + 1) += offset.at(i);
+
+    /*
+     * Two counting passes instead of sorting every list
+     * pass 1: for edge (a, b), put b into a's bucket and a into b's bucket (unordered)
+     * pass 2: scan buckets by owner vid from small to large, put owner into each related vertex's bucket again
+     * Since relationship is symmetric, the result bucket of every vertex is ordered by vid
+    */
+    auto cursor = std::vector<int>(offset.begin(), offset.end() - 1);
+    auto related = std::vector<int>(offset.at(vCount));
+    for(const auto &e : eSet)
+    {
+        if(e.src == e.dst) continue;
+        related.at(cursor.at(e.src)++) = e.dst;
+        related.at(cursor.at(e.dst)++) = e.src;
+    }
 
+    arena.assign(offset.at(vCount), std::pair<int, char>(-1, MARK_UNVISITED));
+    cursor.assign(offset.begin(), offset.end() - 1);
+    for(int i = 0; i < vCount; i++)
+    {
+        for(int j = offset.at(i); j < offset.at(i + 1); j++)
+            arena.at(cursor.at(related.at(j))++).first = i;
+    }
+
+    //Merge duplicated edges so that every related vertex owns exactly one vState, and compact the arena
+    int arenaSize = 0;
+    for(int i = 0; i < vCount; i++)
+    {
+        vValues[i].vStateOffset = arenaSize;
+        for(int j = offset.at(i); j < offset.at(i + 1); j++)
+        {
+            if(arenaSize == vValues[i].vStateOffset || arena.at(arenaSize - 1).first != arena.at(j).first)
+                arena.at(arenaSize++) = arena.at(j);
+        }
+        vValues[i].relatedVCount = arenaSize - vValues[i].vStateOffset;
+        vValues[i].vStateCursor = 0;
+    }
+    arena.resize(arenaSize);
 }
 
 template <typename VertexValueType, typename MessageValueType>
-void DDFS<VertexValueType, MessageValueType>::Free()
+void DDFS<VertexValueType, MessageValueType>::setVState(const VertexValueType &vV, int index, char mark)
 {
+    this->arena->vStateList[vV.vStateOffset + index].second = mark;
+    if(this->arena->isTracked) this->arena->changedVStates.emplace_back(vV.vStateOffset + index);
+}
 
+template <typename VertexValueType, typename MessageValueType>
+void DDFS<VertexValueType, MessageValueType>::logVertex(int vid)
+{
+    if(this->arena->isTracked) this->arena->changedVertices.emplace_back(vid);
 }
 
 template<typename VertexValueType, typename MessageValueType>
@@ -351,113 +473,335 @@ DDFS<VertexValueType, MessageValueType>::DivideGraphByEdge(const Graph<VertexVal
     }
 
     //Init subGs parameters
-    auto templateBlankVV = std::vector<VertexValueType>(g.vCount, VertexValueType());
-    for(int i = 0; i < g.vCount; i++)
+    //vState ranges will be rewritten after vStates are distributed
+    for(int i = 0; i < partitionCount; i++)
+        res.emplace_back(Graph<VertexValueType>(g.vList, eG.at(i), g.verticesValue));
+
+    //A vState (and its reversed one) is owned by the subgraph which gets the first edge between these two vertices
+    //Duplicated edges in other subgraphs will not generate vStates
+    this->arena = &this->globalArena;
+    this->vStateOwner.assign(this->globalArena.vStateList.size(), -1);
+    for(int i = 0; i < partitionCount; i++)
     {
-        templateBlankVV.at(i).state = g.verticesValue.at(i).state;
-        templateBlankVV.at(i).opbit = g.verticesValue.at(i).opbit;
-        templateBlankVV.at(i).vNextMSGTo = g.verticesValue.at(i).vNextMSGTo;
-        templateBlankVV.at(i).startTime = g.verticesValue.at(i).startTime;
-        templateBlankVV.at(i).endTime = g.verticesValue.at(i).endTime;
+        for(const auto &e : eG.at(i))
+        {
+            if(e.src == e.dst) continue;
+
+            const auto &vVSrc = g.verticesValue.at(e.src);
+            const auto &vVDst = g.verticesValue.at(e.dst);
+            int srcIndex = vVSrc.vStateOffset + this->findVState(vVSrc, e.dst);
+            int dstIndex = vVDst.vStateOffset + this->findVState(vVDst, e.src);
+            if(this->vStateOwner.at(srcIndex) == -1) this->vStateOwner.at(srcIndex) = i;
+            if(this->vStateOwner.at(dstIndex) == -1) this->vStateOwner.at(dstIndex) = i;
+        }
     }
 
-    for(int i = 0; i < partitionCount; i++)
-        res.emplace_back(Graph<VertexValueType>(g.vList, eG.at(i), templateBlankVV));
+    //Distribute vStates with their marks into subgraph arenas
+    //Every vState is mapped to its slot in owner subgraph arena here once, then only changed vStates are synchronized
+    this->subGArena.assign(partitionCount, DFSStateArena());
+    for(auto &subArena : this->subGArena)
+    {
+        subArena.isTracked = true;
+        subArena.isBoundary.assign(g.vCount, false);
+    }
+    this->vStateOwnerIndex.assign(this->globalArena.vStateList.size(), -1);
 
-    for(auto &subG : res)
+    for(int v = 0; v < g.vCount; v++)
     {
-        //Scan edges in each subgraph and collect info
-        /*
-         * for edge (a, b):
-         *     add pair (b, MARK_UNVISITED) as (vid, mark) into a's vState priority queue ordered by vid
-         *     add pair (a, MARK_UNVISITED) as (vid, mark) into b's vState priority queue ordered by vid
-        */
-        auto pqVector = std::vector<std::priority_queue<std::pair<int, char>, std::vector<std::pair<int, char>>, cmp>>(g.vCount, std::priority_queue<std::pair<int, char>, std::vector<std::pair<int, char>>, cmp>());
-        for(const auto &e : subG.eList)
+        const auto &vV = g.verticesValue.at(v);
+
+        for(int k = 0; k < partitionCount; k++)
+            res.at(k).verticesValue.at(v).vStateOffset = this->subGArena.at(k).vStateList.size();
+
+        for(int index = vV.vStateOffset; index < vV.vStateOffset + vV.relatedVCount; index++)
         {
-            pqVector.at(e.src).push(std::pair<int, char>(e.dst, MARK_UNVISITED));
-            pqVector.at(e.dst).push(std::pair<int, char>(e.src, MARK_UNVISITED));
+            auto &subArena = this->subGArena.at(this->vStateOwner.at(index));
+            this->vStateOwnerIndex.at(index) = subArena.vStateList.size();
+            subArena.vStateList.emplace_back(this->globalArena.vStateList.at(index));
+            subArena.globalIndex.emplace_back(index);
         }
 
-        //For every vertex (for example i), pull sorted vState pairs from pq and push them into g.verticesValue.at(i).vStateList
-        //The order of verticesValue.vStateList in subgraph can be ensured
-        for(int i = 0; i < subG.vCount; i++)
+        for(int k = 0; k < partitionCount; k++)
         {
-            while(!pqVector.at(i).empty())
-            {
-                subG.verticesValue.at(i).vStateList.emplace_back(pqVector.at(i).top());
-                subG.verticesValue.at(i).relatedVCount++;
-                pqVector.at(i).pop();
-            }
+            auto &vVSub = res.at(k).verticesValue.at(v);
+            vVSub.relatedVCount = this->subGArena.at(k).vStateList.size() - vVSub.vStateOffset;
+            //Vertex with all vStates in this subgraph can search locally, and its cursor is the same as the global one
+            this->subGArena.at(k).isBoundary.at(v) = vVSub.relatedVCount != vV.relatedVCount;
+            vVSub.vStateCursor = this->subGArena.at(k).isBoundary.at(v) ? 0 : vV.vStateCursor;
         }
     }
 
-    //Copy vState from global graph into corresponding subgraph.verticesValue.vStateList
-    int subGCount = partitionCount;
-    int *subGIndex = new int [subGCount];
+    this->globalArena.isTracked = true;
+    this->globalArena.changedVertices.clear();
+    this->globalArena.changedVStates.clear();
 
-    for(int i = 0; i < g.vCount; i++)
+    return res;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int DDFS<VertexValueType, MessageValueType>::search(int vid, int numOfInitV, const int *initVSet, Vertex *vSet, VertexValueType *vValues, int &avCount)
+{
+    auto &vV = vValues[vid];
+
+    this->logVertex(vid);
+
+    //vStates of this vertex are not all here, leave it to MergeGraph
+    if(!this->arena->isBoundary.empty() && this->arena->isBoundary.at(vid))
+    {
+        vV.opbit |= OP_SEARCH_DEFERRED;
+        return -1;
+    }
+
+    //Skip vStates which have been visited since last search
+    while(vV.vStateCursor < vV.relatedVCount && this->arena->vStateList[vV.vStateOffset + vV.vStateCursor].second != MARK_UNVISITED)
+        vV.vStateCursor++;
+
+    //Vertex which will send msg will be activated
+    if(vV.vStateCursor < vV.relatedVCount)
+    {
+        this->setVState(vV, vV.vStateCursor, MARK_SON);
+        vV.opbit |= OP_MSG_FROM_SEARCH;
+        vV.opbit |= OP_MSG_DOWNWARD;
+        if(!vSet[vid].isActive)
+            avCount++;
+        vSet[vid].isActive = true;
+        return this->arena->vStateList[vV.vStateOffset + vV.vStateCursor].first;
+    }
+    //Root has no parent and the whole process ends here
+    else if(vV.vParent == -1) return -1;
+    else
+    {
+        if(!vSet[vid].isActive)
+            avCount++;
+        vSet[vid].isActive = true;
+        vV.opbit |= OP_MSG_FROM_SEARCH;
+        return vV.vParent;
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+bool DDFS<VertexValueType, MessageValueType>::receiveToken(int src, int dst, int numOfInitV, const int *initVSet, Vertex *vSet, VertexValueType *vValues, int &avCount,
+                                                           std::vector<int> &tokenHolders)
+{
+    auto &vV = vValues[dst];
+    int index = this->findVState(vV, src);
+    if(index == -1) return false;
+
+    if(vV.state == STATE_IDLE)
     {
-        for(int j = 0; j < subGCount; j++) subGIndex[j] = 0;
-        for(int j = 0; j < g.verticesValue.at(i).relatedVCount; j++)
+        //Mark src as dst's father
+        this->setVState(vV, index, MARK_PARENT);
+        vV.vParent = src;
+        vV.vRoot = vValues[src].vRoot;
+
+        vV.state = STATE_DISCOVERED;
+        this->logVertex(dst);
+
+        //Related vertices in current arena see dst as visited before anyone searches again
+        this->broadcastLocally(dst, numOfInitV, initVSet, vSet, vValues, avCount, tokenHolders);
+
+        //Related vertices in other subgraphs still need broadcast msg "visited"
+        if(!this->arena->isBoundary.empty() && this->arena->isBoundary.at(dst))
         {
-            const auto &vV = g.verticesValue.at(i).vStateList.at(j);
-            for(int k = 0; k < subGCount; k++)
+            vV.opbit |= OP_BROADCAST;
+
+            //Vertex which will send msg will be activated
+            if(!vSet[dst].isActive)
             {
-                if(res.at(k).verticesValue.at(i).vStateList.at(subGIndex[k]).first == vV.first)
-                {
-                    res.at(k).verticesValue.at(i).vStateList.at(subGIndex[k]).second = vV.second;
-                    subGIndex[k]++;
-                    break;
-                }
+                vSet[dst].isActive = true;
+                avCount++;
             }
         }
+
+        vV.vNextMSGTo = this->search(dst, numOfInitV, initVSet, vSet, vValues, avCount);
+        return true;
+    }
+    //Token returned from a son whose subtree is finished
+    else if(this->arena->vStateList[vV.vStateOffset + index].second == MARK_SON)
+    {
+        this->setVState(vV, index, MARK_VISITED);
+        vV.vNextMSGTo = this->search(dst, numOfInitV, initVSet, vSet, vValues, avCount);
+        return true;
     }
+    //dst has been discovered by the token of another tree, bounce the token back to src
+    //Both vStates are in current arena since they have the same owner
+    else
+    {
+        if(this->arena->vStateList[vV.vStateOffset + index].second == MARK_UNVISITED)
+            this->setVState(vV, index, MARK_VISITED);
 
-    return res;
+        auto &vVSrc = vValues[src];
+        int srcIndex = this->findVState(vVSrc, dst);
+        if(srcIndex != -1 && this->arena->vStateList[vVSrc.vStateOffset + srcIndex].second == MARK_SON)
+        {
+            this->setVState(vVSrc, srcIndex, MARK_VISITED);
+            vVSrc.vNextMSGTo = this->search(src, numOfInitV, initVSet, vSet, vValues, avCount);
+            tokenHolders.emplace_back(src);
+        }
+        return false;
+    }
 }
 
 template <typename VertexValueType, typename MessageValueType>
-int DDFS<VertexValueType, MessageValueType>::search(int vid, int numOfInitV, const int *initVSet, Vertex *vSet, VertexValueType *vValues, int &avCount)
+void DDFS<VertexValueType, MessageValueType>::broadcastLocally(int vid, int numOfInitV, const int *initVSet, Vertex *vSet, VertexValueType *vValues, int &avCount,
+                                                               std::vector<int> &tokenHolders)
 {
-    bool chk = false;
-    for(auto &vState : vValues[vid].vStateList)
+    const auto &vV = vValues[vid];
+    for(int j = vV.vStateOffset; j < vV.vStateOffset + vV.relatedVCount; j++)
     {
-        if(!(vState.second == MARK_VISITED))
+        const auto &vState = this->arena->vStateList[j];
+        if(vState.second != MARK_UNVISITED && vState.second != MARK_VISITED) continue;
+
+        //Reversed vState has the same owner, so it is always in current arena
+        int related = vState.first;
+        auto &vVRelated = vValues[related];
+        int index = this->findVState(vVRelated, vid);
+        if(index == -1) continue;
+
+        char mark = this->arena->vStateList[vVRelated.vStateOffset + index].second;
+        if(mark == MARK_UNVISITED)
+            this->setVState(vVRelated, index, MARK_VISITED);
+        //Token sent by related vertex of another tree will be dropped by vid
+        else if(mark == MARK_SON)
         {
-            chk = true;
-            vState.second = MARK_SON;
-            vValues[vid].opbit |= OP_MSG_FROM_SEARCH;
-            vValues[vid].opbit |= OP_MSG_DOWNWARD;
-            //Vertex which will send msg will be activated
-            if(!vSet[vid].isActive)
-                avCount++;
-            vSet[vid].isActive = true;
-            return vState.first;
+            this->setVState(vVRelated, index, MARK_VISITED);
+            vVRelated.vNextMSGTo = this->search(related, numOfInitV, initVSet, vSet, vValues, avCount);
+            tokenHolders.emplace_back(related);
         }
     }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void DDFS<VertexValueType, MessageValueType>::passTokenLocally(int numOfInitV, const int *initVSet, Vertex *vSet, VertexValueType *vValues, int &avCount,
+                                                               std::vector<int> &tokenHolders)
+{
+    std::stable_sort(tokenHolders.begin(), tokenHolders.end(),
+                     [&](int a, int b){return vValues[a].vRoot < vValues[b].vRoot;});
 
-    if(!chk)
+    //Tokens dropped during passing are appended and passed after the others
+    for(int i = 0; i < (int)tokenHolders.size(); i++)
     {
-        if(vid == initVSet[0]) return -1;
-        else
+        int v = tokenHolders.at(i);
+        while(vValues[v].opbit & OP_MSG_FROM_SEARCH)
         {
-            //There should be some approach more efficient
-            for(auto &vState : vValues[vid].vStateList)
+            auto &vV = vValues[v];
+            int next = vV.vNextMSGTo;
+
+            //vState of next is in other subgraph, send msg token in next superstep
+            if(this->findVState(vV, next) == -1) break;
+
+            //msg token is consumed here
+            vV.opbit &= ~(OP_MSG_FROM_SEARCH | OP_MSG_DOWNWARD);
+            vV.vNextMSGTo = -1;
+            if(!(vV.opbit & OP_BROADCAST) && vSet[v].isActive)
             {
-                if(vState.second == MARK_PARENT)
-                {
-                    //Vertex which will send msg will be activated
-                    if(!vSet[vid].isActive)
-                        avCount++;
-                    vSet[vid].isActive = true;
-                    vValues[vid].opbit |= OP_MSG_FROM_SEARCH;
-                    return vState.first;
-                }
+                vSet[v].isActive = false;
+                avCount--;
             }
 
+            if(!this->receiveToken(v, next, numOfInitV, initVSet, vSet, vValues, avCount, tokenHolders)) break;
+            v = next;
+        }
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int DDFS<VertexValueType, MessageValueType>::findVState(const VertexValueType &vV, int vid)
+{
+    auto begin = this->arena->vStateList.data() + vV.vStateOffset;
+    auto end = begin + vV.relatedVCount;
+    auto it = std::lower_bound(begin, end, vid,
+                               [](const std::pair<int, char> &vState, int id){return vState.first < id;});
+
+    if(it == end || it->first != vid) return -1;
+    else return it - begin;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void DDFS<VertexValueType, MessageValueType>::ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices)
+{
+    auto mMergedSet = MessageSet<MessageValueType>();
+
+    mMergedSet.mSet.clear();
+    MSGGenMerge(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "MGenMerge:" << clock() << std::endl;
+    //Test end
+
+    activeVertices.clear();
+    MSGApply(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "Apply:" << clock() << std::endl;
+    //Test end
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void DDFS<VertexValueType, MessageValueType>::Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    while(activeVertices.size() > 0)
+        ApplyStep(g, initVList, activeVertices);
+
+    Free();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void DDFS<VertexValueType, MessageValueType>::ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    //Subgraphs are divided only once and synchronized with global graph after each merge
+    auto subGraphSet = this->DivideGraphByEdge(g, partitionCount);
+
+    std::vector<std::set<int>> AVSet = std::vector<std::set<int>>();
+    for(int i = 0; i < partitionCount; i++) AVSet.push_back(activeVertices);
+
+    //Test
+    std::cout << "GDivide:" << clock() << std::endl;
+    //Test end
+
+    int iterCount = 0;
+
+    while(activeVertices.size() > 0)
+    {
+        //Test
+        std::cout << ++iterCount << ":" << clock() << std::endl;
+        //Test end
+
+        for(int i = 0; i < partitionCount; i++)
+        {
+            this->arena = &this->subGArena.at(i);
+            ApplyStep(subGraphSet.at(i), initVList, AVSet.at(i));
         }
+
+        MergeGraph(g, subGraphSet, activeVertices, AVSet, initVList);
+        SyncSubGraph(g, subGraphSet, activeVertices, AVSet);
+
+        //Test
+        std::cout << "GMerge:" << clock() << std::endl;
+        //Test end
     }
 
-    return -1;
+    Free();
+
+    //Test
+    std::cout << "end" << ":" << clock() << std::endl;
+    //Test end
 }
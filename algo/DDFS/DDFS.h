@@ -9,6 +9,8 @@
 
 #include "../../core/GraphUtil.h"
 
+#include <type_traits>
+
 //Some state bit
 #define STATE_IDLE false
 #define STATE_DISCOVERED true
@@ -16,6 +18,7 @@
 #define OP_BROADCAST 1
 #define OP_MSG_FROM_SEARCH 2
 #define OP_MSG_DOWNWARD 4
+#define OP_SEARCH_DEFERRED 8
 
 #define MARK_UNVISITED 0
 #define MARK_VISITED 1
@@ -29,24 +32,17 @@
 #define MSG_SEND_VISITED 64
 #define MSG_SEND_RESET 31
 
-//Customised comparison
-struct cmp{
-    bool operator()(std::pair<int, char> a, std::pair<int, char> b)
-    {
-        return a.first > b.first;
-    }
-};
-
 //DFS value class definition
+//DFSValue is trivially copyable: vStates of all vertices are stored in one CSR-style arena owned by DDFS
 class DFSValue
 {
 public:
-    DFSValue() : DFSValue(false, 0, -1, 0, 0, 0, std::vector<std::pair<int, char>>())
+    DFSValue() : DFSValue(false, 0, -1, 0, 0, 0, 0, -1, 0, -1)
     {
 
     }
 
-    DFSValue(bool state, char opbit, int vNextMSGNo, int startTime, int endTime, int relatedVCount, std::vector<std::pair<int, char>> vStateList)
+    DFSValue(bool state, char opbit, int vNextMSGNo, int startTime, int endTime, int relatedVCount, int vStateOffset, int vParent, int vStateCursor, int vRoot)
     {
         this->state = state;
         this->opbit = opbit;
@@ -54,7 +50,10 @@ public:
         this->startTime = startTime;
         this->endTime = endTime;
         this->relatedVCount = relatedVCount;
-        this->vStateList = vStateList;
+        this->vStateOffset = vStateOffset;
+        this->vParent = vParent;
+        this->vStateCursor = vStateCursor;
+        this->vRoot = vRoot;
     }
 
     bool state;
@@ -62,10 +61,47 @@ public:
     int vNextMSGTo;
     int startTime;
     int endTime;
-    int relatedVCount;
 
+    //vStates of this vertex are [vStateOffset, vStateOffset + relatedVCount) in vState arena
     //Ordered by vState.first anytime
+    int relatedVCount;
+    int vStateOffset;
+
+    //Parent vid in DFS tree (-1 for root or undiscovered vertex)
+    int vParent;
+    //Every vState before vStateCursor has been marked as non-unvisited
+    //Marks never go back to MARK_UNVISITED, so search() can continue from here instead of rescanning
+    int vStateCursor;
+    //Root of the DFS tree which this vertex belongs to (-1 for undiscovered vertex)
+    int vRoot;
+};
+
+static_assert(std::is_trivially_copyable<DFSValue>::value, "DFSValue should be able to be copied into shared memory directly");
+
+//vState arena of a graph or a subgraph with the changes made since last synchronization
+class DFSStateArena
+{
+public:
+    DFSStateArena()
+    {
+        this->isTracked = false;
+    }
+
+    //CSR-style storage of vStates indexed by DFSValue::vStateOffset
     std::vector<std::pair<int, char>> vStateList;
+
+    //Changes are only logged when the arena takes part in ApplyD
+    bool isTracked;
+    //Arena indices of changed vStates
+    std::vector<int> changedVStates;
+    //vids of vertices whose values are changed
+    std::vector<int> changedVertices;
+
+    //Subgraph arena only
+    //Arena index in global arena of each vState
+    std::vector<int> globalIndex;
+    //Vertices related to vertices in other subgraphs too, which can only be searched on global arena
+    std::vector<bool> isBoundary;
 };
 
 //DFS msg class definition
@@ -113,7 +149,11 @@ public:
     void Deploy(int vCount, int eCount, int numOfInitV) override;
     void Free() override;
 
+    //Subgraphs generated here share vStates with g through the ownership of vStates
+    //Call it once and use SyncSubGraph after each MergeGraph instead
     std::vector<Graph<VertexValueType>> DivideGraphByEdge(const Graph<VertexValueType> &g, int partitionCount);
+    void SyncSubGraph(const Graph<VertexValueType> &g, std::vector<Graph<VertexValueType>> &subGSet,
+                      const std::set<int> &activeVertices, std::vector<std::set<int>> &activeVerticeSet);
 
     void ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices);
     void Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList);
@@ -123,8 +163,40 @@ public:
 protected:
     int numOfInitV;
 
-    //The whole process will end immediately when this function return -1
+    //vState arena of the graph initialized by GraphInit
+    DFSStateArena globalArena;
+    //vState arenas of subgraphs generated by DivideGraphByEdge
+    std::vector<DFSStateArena> subGArena;
+    //Owner subgraph & arena index in owner subgraph arena of each vState in global arena
+    std::vector<int> vStateOwner;
+    std::vector<int> vStateOwnerIndex;
+    //vState arena which array form functions are working on
+    DFSStateArena *arena;
+
+    //Build sorted and deduplicated vStates of eSet into arena, and set vStateOffset & relatedVCount of vValues
+    void buildVStateArena(int vCount, const std::vector<Edge> &eSet, VertexValueType *vValues, std::vector<std::pair<int, char>> &arena);
+
+    //Modifications of vStates & vertices which should be seen by MergeGraph / SyncSubGraph
+    void setVState(const VertexValueType &vV, int index, char mark);
+    void logVertex(int vid);
+
+    //Return -1 if the token of this tree stops at its root or the search is deferred to MergeGraph
     int search(int vid, int numOfInitV, const int *initVSet, Vertex *vSet, VertexValueType *vValues, int &avCount);
+
+    //Token from src arrives at dst, return false if dst drops it
+    //Vertices whose tokens were dropped and have searched again are appended to tokenHolders
+    bool receiveToken(int src, int dst, int numOfInitV, const int *initVSet, Vertex *vSet, VertexValueType *vValues, int &avCount,
+                      std::vector<int> &tokenHolders);
+    //Apply broadcast msg "visited" of vid to related vertices whose vStates are in current arena
+    void broadcastLocally(int vid, int numOfInitV, const int *initVSet, Vertex *vSet, VertexValueType *vValues, int &avCount,
+                          std::vector<int> &tokenHolders);
+    //Keep passing the tokens held by tokenHolders while their next hops are in current arena
+    //Tokens of lower roots go first
+    void passTokenLocally(int numOfInitV, const int *initVSet, Vertex *vSet, VertexValueType *vValues, int &avCount,
+                          std::vector<int> &tokenHolders);
+
+    //Binary search in sorted vStateList, return index of the first vState of vid or -1 if vid is not related
+    int findVState(const VertexValueType &vV, int vid);
 };
 
 #endif //GRAPH_ALGO_DDFS_H
@@ -4,4 +4,14 @@
 
 #include "DDFS.cpp"
 
-template class DDFS<DFSValue, DFSMSG>;
\ No newline at end of file
+//DFSValue & DFSMSG are defined in algo_DDFS, so the core templates are instantiated here
+#include "../../core/Graph.cpp"
+#include "../../core/GraphUtil.cpp"
+#include "../../core/MessageSet.cpp"
+
+template class Graph<DFSValue>;
+template class GraphUtil<DFSValue, DFSMSG>;
+template class Message<DFSMSG>;
+template class MessageSet<DFSMSG>;
+
+template class DDFS<DFSValue, DFSMSG>;
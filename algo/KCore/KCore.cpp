@@ -0,0 +1,368 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "KCore.h"
+
+#include <iostream>
+#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+KCoreAdjIndex::KCoreAdjIndex()
+{
+    this->vCount = -1;
+    this->maxDegree = 0;
+    this->offset = std::vector<int>();
+    this->adj = std::vector<int>();
+}
+
+//Dirty vertices taken by a thread at a time
+#define KCORE_CHUNK_SIZE 256
+
+template <typename VertexValueType, typename MessageValueType>
+KCore<VertexValueType, MessageValueType>::KCore()
+{
+    this->threadCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int KCore<VertexValueType, MessageValueType>::MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet)
+{
+    //Activity reset
+    activeVertice.clear();
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //MSG Init
+    auto mValues = std::vector<MessageValueType>(g.vCount, (MessageValueType)INVALID_MASSAGE);
+    for(const auto &m : mSet.mSet)
+    {
+        if(mValues.at(m.dst) > m.value)
+            mValues.at(m.dst) = m.value;
+    }
+
+    //array form computation
+    this->MSGApply_array(g.vCount, g.eCount, &g.vList[0], this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Active vertices set assembly
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(g.vList.at(i).isActive)
+            activeVertice.insert(i);
+    }
+
+    return activeVertice.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int KCore<VertexValueType, MessageValueType>::MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet)
+{
+    //Generate merged msgs directly
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //mValues init
+    auto mValues = std::vector<MessageValueType>(g.vCount);
+
+    //array form computation
+    this->MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], g.eList.data(), this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Package merged msg of each vertex to result mSet
+    mSet.mSet.clear();
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(mValues.at(i) != (MessageValueType)INVALID_MASSAGE)
+            mSet.insertMsg(Message<MessageValueType>(i, i, mValues.at(i)));
+    }
+
+    return mSet.mSet.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int KCore<VertexValueType, MessageValueType>::MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues)
+{
+    int avCount = 0;
+
+    for(int i = 0; i < vCount; i++)
+    {
+        vSet[i].isActive = (VertexValueType)mValues[i] < vValues[i];
+        if(vSet[i].isActive)
+        {
+            vValues[i] = (VertexValueType)mValues[i];
+            avCount++;
+        }
+    }
+
+    return avCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int KCore<VertexValueType, MessageValueType>::MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues)
+{
+    if(this->index.vCount != vCount) this->buildIndex(vCount, eCount, eSet);
+    const auto &index = this->index;
+
+    for(int i = 0; i < vCount; i++) mValues[i] = (MessageValueType)INVALID_MASSAGE;
+
+    auto &isInESet = this->isInESetSet[eSet];
+    if(isInESet.size() != vCount)
+    {
+        isInESet.assign(vCount, false);
+        for(int i = 0; i < eCount; i++)
+        {
+            isInESet.at(eSet[i].src) = true;
+            isInESet.at(eSet[i].dst) = true;
+        }
+    }
+
+    //Only neighbors of vertices changed in the last superstep may get smaller h-indexes
+    this->isDirty.resize(vCount, false);
+    this->dirtyVertices.clear();
+    for(int i = 0; i < vCount; i++)
+    {
+        if(!vSet[i].isActive) continue;
+        for(int k = index.offset[i]; k < index.offset[i + 1]; k++)
+        {
+            int v = index.adj[k];
+            if(isInESet[v] && !this->isDirty[v])
+            {
+                this->isDirty[v] = true;
+                this->dirtyVertices.emplace_back(v);
+            }
+        }
+    }
+    for(int v : this->dirtyVertices) this->isDirty[v] = false;
+
+    //h-index of cores of all neighbors, which are counted into buckets no larger than the current core
+    //Threads take chunks of dirty vertices dynamically so that hubs don't stall one thread
+    const auto &dirtyVertices = this->dirtyVertices;
+    int threadCount = std::max(1, std::min(this->threadCount, (int)(dirtyVertices.size() / KCORE_CHUNK_SIZE) + 1));
+    std::atomic<size_t> next(0);
+
+    auto computeChunks = [&]()
+    {
+        auto bucket = std::vector<int>(index.maxDegree + 1);
+        for(size_t begin = next.fetch_add(KCORE_CHUNK_SIZE); begin < dirtyVertices.size(); begin = next.fetch_add(KCORE_CHUNK_SIZE))
+        {
+            for(size_t d = begin; d < std::min(begin + KCORE_CHUNK_SIZE, dirtyVertices.size()); d++)
+            {
+                int v = dirtyVertices[d];
+                int core = (int)vValues[v];
+                if(core <= 0) continue;
+
+                std::fill(bucket.begin(), bucket.begin() + core + 1, 0);
+                for(int k = index.offset[v]; k < index.offset[v + 1]; k++)
+                    bucket[std::min((int)vValues[index.adj[k]], core)]++;
+
+                int h = core, count = 0;
+                for(; h > 0; h--)
+                {
+                    count += bucket[h];
+                    if(count >= h) break;
+                }
+
+                if(h < core) mValues[v] = (MessageValueType)h;
+            }
+        }
+    };
+
+    auto threads = std::vector<std::thread>();
+    for(int t = 1; t < threadCount; t++) threads.emplace_back(computeChunks);
+    computeChunks();
+    for(auto &th : threads) th.join();
+
+    return vCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void KCore<VertexValueType, MessageValueType>::Init(int vCount, int eCount, int numOfInitV)
+{
+    this->numOfInitV = numOfInitV;
+
+    //Memory parameter init
+    this->totalVValuesCount = vCount;
+    this->totalMValuesCount = vCount;
+
+    this->index = KCoreAdjIndex();
+    this->isInESetSet.clear();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void KCore<VertexValueType, MessageValueType>::GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList)
+{
+    this->buildIndex(g.vCount, g.eCount, g.eList.data());
+
+    //vValues init
+    //Cores start from degrees, and every vertex is active at first
+    g.verticesValue.resize(g.vCount);
+    for(int i = 0; i < g.vCount; i++)
+    {
+        g.verticesValue.at(i) = (VertexValueType)(this->index.offset.at(i + 1) - this->index.offset.at(i));
+        g.vList.at(i).isActive = true;
+        activeVertices.insert(i);
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void KCore<VertexValueType, MessageValueType>::Deploy(int vCount, int eCount, int numOfInitV)
+{
+
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void KCore<VertexValueType, MessageValueType>::Free()
+{
+    this->index = KCoreAdjIndex();
+    this->isInESetSet.clear();
+    this->isDirty.clear();
+    this->dirtyVertices.clear();
+    this->mValues.clear();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void KCore<VertexValueType, MessageValueType>::MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                const std::vector<int> &initVList)
+{
+    //Init
+    activeVertices.clear();
+    for(auto &v : g.vList) v.isActive = false;
+
+    //Merge graphs
+    for(const auto &subG : subGSet)
+    {
+        //vSet & vValues merge
+        for(int i = 0; i < subG.vCount; i++)
+        {
+            if(g.verticesValue.at(i) > subG.verticesValue.at(i))
+            {
+                g.verticesValue.at(i) = subG.verticesValue.at(i);
+                g.vList.at(i).isActive = true;
+            }
+        }
+    }
+
+    //Merge active vertices set
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(g.vList.at(i).isActive)
+            activeVertices.insert(i);
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void KCore<VertexValueType, MessageValueType>::buildIndex(int vCount, int eCount, const Edge *eSet)
+{
+    auto &index = this->index;
+    index.vCount = vCount;
+
+    //Counting sort of edges of both directions
+    index.offset.assign(vCount + 1, 0);
+    for(int i = 0; i < eCount; i++)
+    {
+        if(eSet[i].src == eSet[i].dst) continue;
+        index.offset.at(eSet[i].src + 1)++;
+        index.offset.at(eSet[i].dst + 1)++;
+    }
+    for(int i = 0; i < vCount; i++) index.offset.at(i + 1) += index.offset.at(i);
+
+    auto cursor = std::vector<int>(index.offset.begin(), index.offset.end() - 1);
+    index.adj.resize(index.offset.at(vCount));
+    for(int i = 0; i < eCount; i++)
+    {
+        if(eSet[i].src == eSet[i].dst) continue;
+        index.adj.at(cursor.at(eSet[i].src)++) = eSet[i].dst;
+        index.adj.at(cursor.at(eSet[i].dst)++) = eSet[i].src;
+    }
+
+    //Deduplication in place
+    int count = 0;
+    index.maxDegree = 0;
+    for(int i = 0; i < vCount; i++)
+    {
+        auto begin = index.adj.begin() + index.offset.at(i), end = index.adj.begin() + index.offset.at(i + 1);
+        std::sort(begin, end);
+        end = std::unique(begin, end);
+
+        index.offset.at(i) = count;
+        for(auto it = begin; it != end; it++) index.adj.at(count++) = *it;
+        index.maxDegree = std::max(index.maxDegree, count - index.offset.at(i));
+    }
+    index.offset.at(vCount) = count;
+    index.adj.resize(count);
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int KCore<VertexValueType, MessageValueType>::ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet)
+{
+    this->mValues.resize(g.vCount);
+
+    this->MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], g.eList.data(), this->numOfInitV, initVSet.data(), &g.verticesValue[0], &this->mValues[0]);
+
+    //Test
+    std::cout << "MGenMerge:" << clock() << std::endl;
+    //Test end
+
+    int avCount = this->MSGApply_array(g.vCount, g.eCount, &g.vList[0], this->numOfInitV, initVSet.data(), &g.verticesValue[0], &this->mValues[0]);
+
+    //Test
+    std::cout << "Apply:" << clock() << std::endl;
+    //Test end
+
+    return avCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void KCore<VertexValueType, MessageValueType>::Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    int avCount = activeVertices.size();
+    while(avCount > 0)
+        avCount = ApplyStep(g, initVList);
+
+    Free();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void KCore<VertexValueType, MessageValueType>::ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    //Every h-index reads the whole adjacency, so the global step is run directly instead of once per subgraph
+    int iterCount = 0;
+    int avCount = activeVertices.size();
+
+    while(avCount > 0)
+    {
+        //Test
+        std::cout << ++iterCount << ":" << clock() << std::endl;
+        //Test end
+
+        avCount = ApplyStep(g, initVList);
+    }
+
+    Free();
+
+    //Test
+    std::cout << "end" << ":" << clock() << std::endl;
+    //Test end
+}
@@ -0,0 +1,78 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_KCORE_H
+#define GRAPH_ALGO_KCORE_H
+
+#include "../../core/GraphUtil.h"
+
+//Undirected & deduplicated adjacency (CSR) of the whole graph, self loops ignored
+class KCoreAdjIndex
+{
+public:
+    KCoreAdjIndex();
+
+    int vCount;
+    int maxDegree;
+    std::vector<int> offset;
+    std::vector<int> adj;
+};
+
+//Core numbers by h-index iteration: core(v) starts from the degree of v
+//and becomes the h-index of cores of its neighbors until nothing changes
+//vValues[v] is the core (estimation) of v, and mValues[v] is the new h-index of v or INVALID_MASSAGE
+//An h-index needs cores of all neighbors, so it is always computed on the adjacency of the whole graph (index)
+//eSet only selects the vertices computed (its endpoints), which is why results of several edge sets can be combined by min
+template <typename VertexValueType, typename MessageValueType>
+class KCore : public GraphUtil<VertexValueType, MessageValueType>
+{
+public:
+    KCore();
+
+    int MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet) override;
+    int MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet) override;
+
+    int MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues) override;
+    int MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues) override;
+
+    void MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                    std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                    const std::vector<int> &initVList) override;
+
+    void Init(int vCount, int eCount, int numOfInitV) override;
+    void GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList) override;
+    void Deploy(int vCount, int eCount, int numOfInitV) override;
+    void Free() override;
+
+    //Supersteps run on arrays of g directly, and only the count of active vertices is kept between them
+    int ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet);
+    void Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList);
+
+    //Not divided: subgraphs would all run the same global step on the whole adjacency, so ApplyD runs the supersteps of Apply
+    //Each superstep is parallelized by threadCount in MSGGenMerge_array instead, and partitionCount is not used
+    void ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount);
+
+    //Threads used by MSGGenMerge_array
+    int threadCount;
+
+protected:
+    int numOfInitV;
+
+    //Built by GraphInit from the whole graph, or by MSGGenMerge_array from eSet if GraphInit is not called (eSet is the whole graph then)
+    KCoreAdjIndex index;
+
+    //Whether every vertex is an endpoint of some edge in each edge set, built at the first use of each edge set
+    std::map<const Edge *, std::vector<char>> isInESetSet;
+    //Vertices which are endpoints in eSet and have neighbors changed in the last superstep
+    std::vector<char> isDirty;
+    std::vector<int> dirtyVertices;
+    //mValues of ApplyStep, reused between supersteps
+    std::vector<MessageValueType> mValues;
+
+    void buildIndex(int vCount, int eCount, const Edge *eSet);
+};
+
+#endif //GRAPH_ALGO_KCORE_H
@@ -0,0 +1,7 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "KCore.cpp"
+
+template class KCore<int, int>;
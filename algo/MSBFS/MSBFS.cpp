@@ -0,0 +1,402 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "MSBFS.h"
+
+#include <iostream>
+#include <ctime>
+
+MSBFSOutEdgeIndex::MSBFSOutEdgeIndex()
+{
+    this->eCount = -1;
+    this->offset = std::vector<int>();
+    this->dst = std::vector<int>();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+MSBFS<VertexValueType, MessageValueType>::MSBFS()
+{
+    this->laneValues = nullptr;
+    this->laneLevel = MSBFS_UNREACHED;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int MSBFS<VertexValueType, MessageValueType>::MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet)
+{
+    //Activity reset
+    activeVertice.clear();
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //MSG Init
+    //Every msg carries the lane bit of its initV
+    auto mValues = std::vector<MessageValueType>(g.vCount * this->wordCount, (MessageValueType)0);
+    for(const auto &m : mSet.mSet)
+        mValues.at(m.dst * this->wordCount + (g.vList.at(m.src).initVIndex >> 6)) |= m.value;
+
+    //array form computation
+    this->MSGApply_array(g.vCount, g.eCount, &g.vList[0], this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Active vertices set assembly
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(g.vList.at(i).isActive)
+            activeVertice.insert(i);
+    }
+
+    return activeVertice.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int MSBFS<VertexValueType, MessageValueType>::MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet)
+{
+    //Generate merged msgs directly
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //mValues init
+    auto mValues = std::vector<MessageValueType>(g.vCount * this->wordCount);
+
+    //array form computation
+    this->MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], g.eList.data(), this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Package lanes of mValues to result mSet
+    for(int i = 0; i < g.vCount * this->wordCount; i++)
+    {
+        auto bits = mValues.at(i);
+        while(bits)
+        {
+            int lane = ((i % this->wordCount) << 6) + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            mSet.insertMsg(Message<MessageValueType>(initVSet[lane], i / this->wordCount, (MessageValueType)1 << (lane & 63)));
+        }
+    }
+
+    return mSet.mSet.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int MSBFS<VertexValueType, MessageValueType>::MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues)
+{
+    int wordCount = (numOfInitV + 63) >> 6;
+    int level = this->getLevel(vCount, vSet, numOfInitV, vValues);
+    int avCount = 0;
+
+    for(int i = 0; i < vCount; i++) vSet[i].isActive = false;
+
+    if(level == MSBFS_UNREACHED) return 0;
+
+    this->syncLanes(vCount, numOfInitV, vValues, level);
+    auto *seen = this->seen.data();
+    auto *visit = this->visit.data();
+
+    for(int i = 0; i < vCount * wordCount; i++)
+    {
+        //Lanes which have reached the vertex before are masked off by seen
+        auto bits = mValues[i] & ~seen[i];
+        seen[i] |= bits;
+        visit[i] = bits;
+
+        if(bits == 0) continue;
+
+        int v = i / wordCount;
+        if(!vSet[v].isActive)
+        {
+            vSet[v].isActive = true;
+            avCount++;
+        }
+
+        while(bits)
+        {
+            int lane = ((i % wordCount) << 6) + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            vValues[v * numOfInitV + lane] = (VertexValueType)(level + 1);
+        }
+    }
+
+    this->laneLevel = level + 1;
+
+    return avCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int MSBFS<VertexValueType, MessageValueType>::MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues)
+{
+    const auto &index = this->getOutEdgeIndex(vCount, eCount, eSet);
+    int wordCount = (numOfInitV + 63) >> 6;
+
+    for(int i = 0; i < vCount * wordCount; i++) mValues[i] = (MessageValueType)0;
+
+    int level = this->getLevel(vCount, vSet, numOfInitV, vValues);
+    if(level == MSBFS_UNREACHED) return vCount * wordCount;
+
+    //Frontier lanes of every vertex are those which reached it in the last superstep
+    this->syncLanes(vCount, numOfInitV, vValues, level);
+
+    for(int i = 0; i < vCount; i++)
+    {
+        if(!vSet[i].isActive) continue;
+
+        const auto *visit = this->visit.data() + i * wordCount;
+
+        //One scan of out-edges for all lanes
+        //The word loop is plain OR over contiguous words, which compilers vectorize into 128/256-bit ORs
+        for(int e = index.offset[i]; e < index.offset[i + 1]; e++)
+        {
+            auto *next = mValues + index.dst[e] * wordCount;
+            for(int k = 0; k < wordCount; k++) next[k] |= visit[k];
+        }
+    }
+
+    return vCount * wordCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::Init(int vCount, int eCount, int numOfInitV)
+{
+    this->numOfInitV = numOfInitV;
+    this->wordCount = (numOfInitV + 63) >> 6;
+
+    //Memory parameter init
+    this->totalVValuesCount = vCount * numOfInitV;
+    this->totalMValuesCount = vCount * this->wordCount;
+
+    this->ResetRunState();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList)
+{
+    int numOfInitV_init = initVList.size();
+
+    //v Init
+    for(int i = 0; i < numOfInitV_init; i++)
+        g.vList.at(initVList.at(i)).initVIndex = i;
+    for(auto &v : g.vList)
+    {
+        if(v.initVIndex != INVALID_INITV_INDEX)
+        {
+            activeVertices.insert(v.vertexID);
+            v.isActive = true;
+        }
+        else v.isActive = false;
+    }
+
+    //vValues init
+    g.verticesValue.assign(g.vCount * numOfInitV_init, (VertexValueType)MSBFS_UNREACHED);
+    for(int initID : initVList)
+        g.verticesValue.at(initID * numOfInitV_init + g.vList.at(initID).initVIndex) = (VertexValueType)0;
+
+    this->ResetRunState();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::Deploy(int vCount, int eCount, int numOfInitV)
+{
+
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::Free()
+{
+    this->outEdgeIndexSet.clear();
+    this->seen.clear();
+    this->visit.clear();
+    this->ResetRunState();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::ResetRunState()
+{
+    this->laneValues = nullptr;
+    this->laneLevel = MSBFS_UNREACHED;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                const std::vector<int> &initVList)
+{
+    //Init
+    activeVertices.clear();
+    for(auto &v : g.vList) v.isActive = false;
+
+    //Merge graphs
+    for(const auto &subG : subGSet)
+    {
+        //vSet merge
+        for(int i = 0; i < subG.vCount; i++)
+            g.vList.at(i).isActive |= subG.vList.at(i).isActive;
+
+        //vValues merge
+        for(int i = 0; i < subG.verticesValue.size(); i++)
+        {
+            if(g.verticesValue.at(i) > subG.verticesValue.at(i))
+                g.verticesValue.at(i) = subG.verticesValue.at(i);
+        }
+    }
+
+    //Merge active vertices set
+    for(const auto &AVs : activeVerticeSet)
+    {
+        for(auto av : AVs)
+            activeVertices.insert(av);
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+const MSBFSOutEdgeIndex &MSBFS<VertexValueType, MessageValueType>::getOutEdgeIndex(int vCount, int eCount, const Edge *eSet)
+{
+    auto &index = this->outEdgeIndexSet[eSet];
+    if(index.eCount == eCount && index.offset.size() == vCount + 1) return index;
+
+    //Counting sort of edges by src
+    index.eCount = eCount;
+    index.offset.assign(vCount + 1, 0);
+    for(int i = 0; i < eCount; i++) index.offset.at(eSet[i].src + 1)++;
+    for(int i = 0; i < vCount; i++) index.offset.at(i + 1) += index.offset.at(i);
+
+    auto cursor = std::vector<int>(index.offset.begin(), index.offset.end() - 1);
+    index.dst.resize(eCount);
+    for(int i = 0; i < eCount; i++) index.dst.at(cursor.at(eSet[i].src)++) = eSet[i].dst;
+
+    return index;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::syncLanes(int vCount, int numOfInitV, const VertexValueType *vValues, int level)
+{
+    int wordCount = (numOfInitV + 63) >> 6;
+    if(this->laneValues == vValues && this->laneLevel == level && this->seen.size() == vCount * wordCount) return;
+
+    //Only at the first superstep of a run, or when vValues are replaced (such as subgraphs of ApplyD)
+    this->seen.assign(vCount * wordCount, (MessageValueType)0);
+    this->visit.assign(vCount * wordCount, (MessageValueType)0);
+    for(int i = 0; i < vCount; i++)
+    {
+        for(int j = 0; j < numOfInitV; j++)
+        {
+            auto value = vValues[i * numOfInitV + j];
+            if(value == (VertexValueType)MSBFS_UNREACHED) continue;
+            this->seen[i * wordCount + (j >> 6)] |= (MessageValueType)1 << (j & 63);
+            if(value == (VertexValueType)level) this->visit[i * wordCount + (j >> 6)] |= (MessageValueType)1 << (j & 63);
+        }
+    }
+
+    this->laneValues = vValues;
+    this->laneLevel = level;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int MSBFS<VertexValueType, MessageValueType>::getLevel(int vCount, const Vertex *vSet, int numOfInitV, const VertexValueType *vValues)
+{
+    int level = MSBFS_UNREACHED;
+
+    for(int i = 0; i < vCount; i++)
+    {
+        if(!vSet[i].isActive) continue;
+
+        //Hop counts of a vertex never exceed the current level
+        level = 0;
+        for(int j = 0; j < numOfInitV; j++)
+        {
+            if(vValues[i * numOfInitV + j] != (VertexValueType)MSBFS_UNREACHED && level < vValues[i * numOfInitV + j])
+                level = vValues[i * numOfInitV + j];
+        }
+        break;
+    }
+
+    return level;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices)
+{
+    auto mMergedSet = MessageSet<MessageValueType>();
+
+    mMergedSet.mSet.clear();
+    MSGGenMerge(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "MGenMerge:" << clock() << std::endl;
+    //Test end
+
+    activeVertices.clear();
+    MSGApply(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "Apply:" << clock() << std::endl;
+    //Test end
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    while(activeVertices.size() > 0)
+        ApplyStep(g, initVList, activeVertices);
+
+    Free();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void MSBFS<VertexValueType, MessageValueType>::ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    //Edges never change, so subgraphs are divided only once and keep their out-edge indexes
+    auto subGraphSet = this->DivideGraphByEdge(g, partitionCount);
+
+    std::vector<std::set<int>> AVSet = std::vector<std::set<int>>();
+    for(int i = 0; i < partitionCount; i++) AVSet.push_back(std::set<int>());
+
+    int iterCount = 0;
+
+    while(activeVertices.size() > 0)
+    {
+        //Test
+        std::cout << ++iterCount << ":" << clock() << std::endl;
+        //Test end
+
+        for(int i = 0; i < partitionCount; i++)
+        {
+            auto &subG = subGraphSet.at(i);
+            subG.verticesValue = g.verticesValue;
+            for(int j = 0; j < g.vCount; j++) subG.vList.at(j).isActive = g.vList.at(j).isActive;
+            AVSet.at(i) = activeVertices;
+        }
+
+        for(int i = 0; i < partitionCount; i++)
+            ApplyStep(subGraphSet.at(i), initVList, AVSet.at(i));
+
+        MergeGraph(g, subGraphSet, activeVertices, AVSet, initVList);
+
+        //Test
+        std::cout << "GMerge:" << clock() << std::endl;
+        //Test end
+    }
+
+    Free();
+
+    //Test
+    std::cout << "end" << ":" << clock() << std::endl;
+    //Test end
+}
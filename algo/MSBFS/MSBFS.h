@@ -0,0 +1,85 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_MSBFS_H
+#define GRAPH_ALGO_MSBFS_H
+
+#include "../../core/GraphUtil.h"
+
+#include <cstdint>
+
+//The same unreached value as BellmanFord, so that results can be compared directly
+#define MSBFS_UNREACHED (INT32_MAX >> 1)
+
+//Out-edge index (CSR by src) of an edge set
+class MSBFSOutEdgeIndex
+{
+public:
+    MSBFSOutEdgeIndex();
+
+    int eCount;
+    std::vector<int> offset;
+    std::vector<int> dst;
+};
+
+//Multi-source BFS which runs the BFS of every initV together
+//Lanes (initVs) of a vertex are packed into 64-bit words, so that every out-edge of a frontier vertex is scanned once for all lanes
+//vValues[vid * numOfInitV + initVIndex] is the hop count, the same layout as BellmanFord
+//mValues[vid * wordCount + initVIndex / 64] holds the lanes which reached vid in this superstep (visitNext)
+//Lane words seen & visit of every vertex are kept by the executor, so that the frontier is visitNext & ~seen instead of a rescan of hop counts
+template <typename VertexValueType, typename MessageValueType>
+class MSBFS : public GraphUtil<VertexValueType, MessageValueType>
+{
+public:
+    MSBFS();
+
+    int MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet) override;
+    int MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet) override;
+
+    int MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues) override;
+    int MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues) override;
+
+    void MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                    std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                    const std::vector<int> &initVList) override;
+
+    void Init(int vCount, int eCount, int numOfInitV) override;
+    void GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList) override;
+    void Deploy(int vCount, int eCount, int numOfInitV) override;
+    void Free() override;
+    void ResetRunState() override;
+
+    void ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices);
+    void Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList);
+
+    void ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount);
+
+protected:
+    int numOfInitV;
+    int wordCount;
+
+    //Out-edge indexes of edge sets used by MSGGenMerge_array, built at the first use of each edge set
+    std::map<const Edge *, MSBFSOutEdgeIndex> outEdgeIndexSet;
+
+    //seen[vid * wordCount + k]: lanes which have reached vid
+    //visit[vid * wordCount + k]: lanes which reached vid at laneLevel (the frontier)
+    //Both are built from laneValues at laneLevel, and rebuilt when the kernels are given other vValues or another level
+    std::vector<MessageValueType> seen;
+    std::vector<MessageValueType> visit;
+    const VertexValueType *laneValues;
+    int laneLevel;
+
+    const MSBFSOutEdgeIndex &getOutEdgeIndex(int vCount, int eCount, const Edge *eSet);
+
+    //Rebuilds seen & visit from hop counts unless they are already built from vValues at level
+    void syncLanes(int vCount, int numOfInitV, const VertexValueType *vValues, int level);
+
+    //All initVs start together, so the frontier of every lane is at the same hop count
+    //which is the largest hop count of active vertices (those reached in the last superstep)
+    int getLevel(int vCount, const Vertex *vSet, int numOfInitV, const VertexValueType *vValues);
+};
+
+#endif //GRAPH_ALGO_MSBFS_H
@@ -0,0 +1,15 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "MSBFS.cpp"
+
+//Lane words are not a msg type of core, so the core templates are instantiated here
+#include "../../core/MessageSet.cpp"
+#include "../../core/GraphUtil.cpp"
+
+template class Message<uint64_t>;
+template class MessageSet<uint64_t>;
+template class GraphUtil<int, uint64_t>;
+
+template class MSBFS<int, uint64_t>;
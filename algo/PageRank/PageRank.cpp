@@ -0,0 +1,411 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "PageRank.h"
+
+#include <iostream>
+#include <ctime>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+PRInEdgeIndex::PRInEdgeIndex()
+{
+    this->eCount = -1;
+    this->offset = std::vector<int>();
+    this->src = std::vector<int>();
+}
+
+//Reads of contribution are random, so contributions of in-edges a bit further are prefetched
+#define PR_PREFETCH_DISTANCE 32
+
+//Sum of contribution[src[begin .. end)]
+//src[0 .. srcCount) is the whole in-edge list, which bounds prefetching
+static inline double sumContribution(const int *src, int begin, int end, int srcCount, const double *contribution)
+{
+    int i = begin;
+    double res;
+
+#if defined(__AVX2__)
+    __m256d sum = _mm256_setzero_pd();
+    for(; i + 4 <= end; i += 4)
+    {
+        if(i + PR_PREFETCH_DISTANCE + 4 <= srcCount)
+        {
+            for(int j = i + PR_PREFETCH_DISTANCE; j < i + PR_PREFETCH_DISTANCE + 4; j++) __builtin_prefetch(contribution + src[j]);
+        }
+        sum = _mm256_add_pd(sum, _mm256_i32gather_pd(contribution, _mm_loadu_si128((const __m128i *)(src + i)), sizeof(double)));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    res = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__SSE2__)
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    for(; i + 4 <= end; i += 4)
+    {
+        if(i + PR_PREFETCH_DISTANCE + 4 <= srcCount)
+        {
+            for(int j = i + PR_PREFETCH_DISTANCE; j < i + PR_PREFETCH_DISTANCE + 4; j++) __builtin_prefetch(contribution + src[j]);
+        }
+        sum0 = _mm_add_pd(sum0, _mm_set_pd(contribution[src[i + 1]], contribution[src[i]]));
+        sum1 = _mm_add_pd(sum1, _mm_set_pd(contribution[src[i + 3]], contribution[src[i + 2]]));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(sum0, sum1));
+    res = lanes[0] + lanes[1];
+#else
+    //Independent partial sums so that additions are not serialized
+    double sum[4] = {0, 0, 0, 0};
+    for(; i + 4 <= end; i += 4)
+    {
+        sum[0] += contribution[src[i]];
+        sum[1] += contribution[src[i + 1]];
+        sum[2] += contribution[src[i + 2]];
+        sum[3] += contribution[src[i + 3]];
+    }
+    res = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+#endif
+
+    for(; i < end; i++)
+    {
+        if(i + PR_PREFETCH_DISTANCE < srcCount) __builtin_prefetch(contribution + src[i + PR_PREFETCH_DISTANCE]);
+        res += contribution[src[i]];
+    }
+
+    return res;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+PageRank<VertexValueType, MessageValueType>::PageRank(double dampingFactor, double epsilon, bool isDeltaMode)
+{
+    this->dampingFactor = dampingFactor;
+    this->epsilon = epsilon;
+    this->isDeltaMode = isDeltaMode;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int PageRank<VertexValueType, MessageValueType>::MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet)
+{
+    //Activity reset
+    activeVertice.clear();
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //MSG Init
+    auto mValues = std::vector<MessageValueType>(g.vCount, (MessageValueType)0);
+    for(const auto &m : mSet.mSet) mValues.at(m.dst) += m.value;
+
+    //array form computation
+    this->MSGApply_array(g.vCount, g.vCount, &g.vList[0], this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Active vertices set assembly
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(g.vList.at(i).isActive)
+            activeVertice.insert(i);
+    }
+
+    return activeVertice.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int PageRank<VertexValueType, MessageValueType>::MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet)
+{
+    //Generate merged msgs directly
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //mValues init
+    auto mValues = std::vector<MessageValueType>(g.vCount, (MessageValueType)0);
+
+    //array form computation
+    this->MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], g.eList.data(), this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Package merged msg of each vertex to result mSet
+    mSet.mSet.clear();
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(mValues.at(i) != (MessageValueType)0)
+            mSet.insertMsg(Message<MessageValueType>(i, i, mValues.at(i)));
+    }
+
+    return mSet.mSet.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int PageRank<VertexValueType, MessageValueType>::MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues)
+{
+    for(int i = 0; i < vCount; i++) vValues[i].acc = mValues[i];
+
+    return this->updateRank(vCount, vSet, vValues);
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int PageRank<VertexValueType, MessageValueType>::MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues)
+{
+    const auto &index = this->getInEdgeIndex(vCount, eCount, eSet);
+
+    //Contribution of each vertex is computed once rather than once per out-edge
+    this->contribution.resize(vCount);
+    for(int i = 0; i < vCount; i++)
+    {
+        if(vSet[i].isActive && vValues[i].outDegree > 0)
+            this->contribution[i] = (this->isDeltaMode ? vValues[i].delta : vValues[i].rank) / vValues[i].outDegree;
+        else this->contribution[i] = 0;
+    }
+
+    //Pull contributions along in-edges, so that every mValues[i] is written once
+    for(int i = 0; i < vCount; i++)
+        mValues[i] = (MessageValueType)sumContribution(index.src.data(), index.offset[i], index.offset[i + 1], eCount, this->contribution.data());
+
+    return vCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+bool PageRank<VertexValueType, MessageValueType>::isMSGMergeable()
+{
+    return true;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void PageRank<VertexValueType, MessageValueType>::MSGMerge_array(int vCount, int numOfInitV, MessageValueType *mValues, const MessageValueType *mValuesOther)
+{
+    //Sums of contributions along disjoint edge sets
+    for(int i = 0; i < vCount; i++) mValues[i] += mValuesOther[i];
+}
+
+template <typename VertexValueType, typename MessageValueType>
+bool PageRank<VertexValueType, MessageValueType>::isApplyVertexLocal()
+{
+    //The base rank of the normal mode is divided by vCount, and convergence is checked on all vertices
+    return this->isDeltaMode;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void PageRank<VertexValueType, MessageValueType>::Init(int vCount, int eCount, int numOfInitV)
+{
+    this->numOfInitV = numOfInitV;
+
+    //Memory parameter init
+    this->totalVValuesCount = vCount;
+    this->totalMValuesCount = vCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void PageRank<VertexValueType, MessageValueType>::GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList)
+{
+    //vValues init
+    //Delta mode starts from propagating (1 - d) / N of every vertex
+    double initRank = this->isDeltaMode ? (1 - this->dampingFactor) / g.vCount : 1.0 / g.vCount;
+    g.verticesValue.assign(g.vCount, VertexValueType(initRank, this->isDeltaMode ? initRank : 0, 0, 0));
+
+    for(const auto &e : g.eList) g.verticesValue.at(e.src).outDegree++;
+
+    //Every vertex is active at first
+    for(auto &v : g.vList)
+    {
+        v.isActive = true;
+        activeVertices.insert(v.vertexID);
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void PageRank<VertexValueType, MessageValueType>::Deploy(int vCount, int eCount, int numOfInitV)
+{
+
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void PageRank<VertexValueType, MessageValueType>::Free()
+{
+    this->inEdgeIndexSet.clear();
+    this->contribution.clear();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void PageRank<VertexValueType, MessageValueType>::MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                const std::vector<int> &initVList)
+{
+    //acc merge
+    //Ranks computed by subGs are based on parts of acc, so they are recomputed from g here
+    for(int i = 0; i < g.vCount; i++)
+    {
+        double acc = 0;
+        for(const auto &subG : subGSet) acc += subG.verticesValue.at(i).acc;
+        g.verticesValue.at(i).acc = acc;
+    }
+
+    this->updateRank(g.vCount, &g.vList[0], &g.verticesValue[0]);
+
+    //Merge active vertices set
+    activeVertices.clear();
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(g.vList.at(i).isActive)
+            activeVertices.insert(i);
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+const PRInEdgeIndex &PageRank<VertexValueType, MessageValueType>::getInEdgeIndex(int vCount, int eCount, const Edge *eSet)
+{
+    auto &index = this->inEdgeIndexSet[eSet];
+    if(index.eCount == eCount && index.offset.size() == vCount + 1) return index;
+
+    //Counting sort of edges by dst
+    index.eCount = eCount;
+    index.offset.assign(vCount + 1, 0);
+    for(int i = 0; i < eCount; i++) index.offset.at(eSet[i].dst + 1)++;
+    for(int i = 0; i < vCount; i++) index.offset.at(i + 1) += index.offset.at(i);
+
+    auto cursor = std::vector<int>(index.offset.begin(), index.offset.end() - 1);
+    index.src.resize(eCount);
+    for(int i = 0; i < eCount; i++) index.src.at(cursor.at(eSet[i].dst)++) = eSet[i].src;
+
+    return index;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int PageRank<VertexValueType, MessageValueType>::updateRank(int vCount, Vertex *vSet, VertexValueType *vValues)
+{
+    int avCount = 0;
+    //vCount is the count of a slice of vertices when applied locally, while ranks average 1 / N of all N vertices (one vValue each)
+    double threshold = this->epsilon / this->totalVValuesCount;
+
+    if(this->isDeltaMode)
+    {
+        for(int i = 0; i < vCount; i++)
+        {
+            auto &vV = vValues[i];
+
+            //Changes of active vertices have been propagated in this superstep
+            if(vSet[i].isActive) vV.delta = 0;
+
+            double inc = this->dampingFactor * vV.acc;
+            vV.rank += inc;
+            vV.delta += inc;
+
+            vSet[i].isActive = std::fabs(vV.delta) > threshold;
+            if(vSet[i].isActive) avCount++;
+        }
+    }
+    else
+    {
+        double base = (1 - this->dampingFactor) / vCount;
+        double maxDelta = 0;
+
+        for(int i = 0; i < vCount; i++)
+        {
+            auto &vV = vValues[i];
+            double rank = base + this->dampingFactor * vV.acc;
+            vV.delta = rank - vV.rank;
+            vV.rank = rank;
+            if(maxDelta < std::fabs(vV.delta)) maxDelta = std::fabs(vV.delta);
+        }
+
+        //Every rank is recomputed until all of them converge
+        bool isConverged = maxDelta <= threshold;
+        for(int i = 0; i < vCount; i++) vSet[i].isActive = !isConverged;
+        avCount = isConverged ? 0 : vCount;
+    }
+
+    return avCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void PageRank<VertexValueType, MessageValueType>::ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices)
+{
+    auto mMergedSet = MessageSet<MessageValueType>();
+
+    mMergedSet.mSet.clear();
+    MSGGenMerge(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "MGenMerge:" << clock() << std::endl;
+    //Test end
+
+    activeVertices.clear();
+    MSGApply(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "Apply:" << clock() << std::endl;
+    //Test end
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void PageRank<VertexValueType, MessageValueType>::Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    while(activeVertices.size() > 0)
+        ApplyStep(g, initVList, activeVertices);
+
+    Free();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void PageRank<VertexValueType, MessageValueType>::ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    //Edges never change, so subgraphs are divided only once and keep their in-edge indexes
+    auto subGraphSet = this->DivideGraphByEdge(g, partitionCount);
+
+    std::vector<std::set<int>> AVSet = std::vector<std::set<int>>();
+    for(int i = 0; i < partitionCount; i++) AVSet.push_back(std::set<int>());
+
+    int iterCount = 0;
+
+    while(activeVertices.size() > 0)
+    {
+        //Test
+        std::cout << ++iterCount << ":" << clock() << std::endl;
+        //Test end
+
+        for(int i = 0; i < partitionCount; i++)
+        {
+            auto &subG = subGraphSet.at(i);
+            subG.verticesValue = g.verticesValue;
+            for(int j = 0; j < g.vCount; j++) subG.vList.at(j).isActive = g.vList.at(j).isActive;
+            AVSet.at(i) = activeVertices;
+        }
+
+        for(int i = 0; i < partitionCount; i++)
+            ApplyStep(subGraphSet.at(i), initVList, AVSet.at(i));
+
+        MergeGraph(g, subGraphSet, activeVertices, AVSet, initVList);
+
+        //Test
+        std::cout << "GMerge:" << clock() << std::endl;
+        //Test end
+    }
+
+    Free();
+
+    //Test
+    std::cout << "end" << ":" << clock() << std::endl;
+    //Test end
+}
@@ -0,0 +1,108 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_PAGERANK_H
+#define GRAPH_ALGO_PAGERANK_H
+
+#include "../../core/GraphUtil.h"
+
+#include <type_traits>
+
+//PageRank value class definition
+class PRValue
+{
+public:
+    PRValue() : PRValue(0, 0, 0, 0)
+    {
+
+    }
+
+    PRValue(double rank, double delta, double acc, int outDegree)
+    {
+        this->rank = rank;
+        this->delta = delta;
+        this->acc = acc;
+        this->outDegree = outDegree;
+    }
+
+    double rank;
+    //Normal mode: rank change of last iteration
+    //Delta mode: rank change which hasn't been propagated to out-neighbors yet
+    double delta;
+    //Sum of contributions of in-neighbors in this iteration
+    //Only a part of the sum in a subgraph, which is completed by MergeGraph (or the client)
+    double acc;
+    //Out-degree in the whole graph
+    int outDegree;
+};
+
+static_assert(std::is_trivially_copyable<PRValue>::value, "PRValue should be able to be copied into shared memory directly");
+
+//In-edge index (CSR by dst) of an edge set
+class PRInEdgeIndex
+{
+public:
+    PRInEdgeIndex();
+
+    int eCount;
+    std::vector<int> offset;
+    std::vector<int> src;
+};
+
+template <typename VertexValueType, typename MessageValueType>
+class PageRank : public GraphUtil<VertexValueType, MessageValueType>
+{
+public:
+    //epsilon is relative to the average rank 1 / N, so that the threshold of changes is epsilon / N for any N
+    //Delta mode propagates only rank changes, and a vertex stays active while its unpropagated change is larger than epsilon / N
+    //Normal mode recomputes every rank until no rank changes more than epsilon / N
+    PageRank(double dampingFactor = 0.85, double epsilon = 1e-7, bool isDeltaMode = false);
+
+    int MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet) override;
+    int MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet) override;
+
+    //mValues[v] is the sum of contributions pulled from in-edges of v in eSet
+    int MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues) override;
+    int MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues) override;
+
+    bool isMSGMergeable() override;
+    void MSGMerge_array(int vCount, int numOfInitV, MessageValueType *mValues, const MessageValueType *mValuesOther) override;
+    bool isApplyVertexLocal() override;
+
+    void MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                    std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                    const std::vector<int> &initVList) override;
+
+    void Init(int vCount, int eCount, int numOfInitV) override;
+    void GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList) override;
+    void Deploy(int vCount, int eCount, int numOfInitV) override;
+    void Free() override;
+
+    void ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices);
+    void Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList);
+
+    void ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount);
+
+    double dampingFactor;
+    double epsilon;
+    bool isDeltaMode;
+
+protected:
+    int numOfInitV;
+
+    //In-edge indexes of edge sets used by MSGGenMerge_array, built at the first use of each edge set
+    //Edge sets are never modified between supersteps (the same for shared memory of UtilServer)
+    std::map<const Edge *, PRInEdgeIndex> inEdgeIndexSet;
+    //rank / outDegree (or delta / outDegree) of every vertex in this superstep
+    std::vector<double> contribution;
+
+    const PRInEdgeIndex &getInEdgeIndex(int vCount, int eCount, const Edge *eSet);
+
+    //Compute new ranks from complete acc, vertices which sent contributions in this superstep are active in vSet
+    int updateRank(int vCount, Vertex *vSet, VertexValueType *vValues);
+};
+
+#endif //GRAPH_ALGO_PAGERANK_H
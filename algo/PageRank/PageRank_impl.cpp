@@ -0,0 +1,14 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "PageRank.cpp"
+
+//PRValue is defined in algo_PageRank, so the core templates are instantiated here
+#include "../../core/Graph.cpp"
+#include "../../core/GraphUtil.cpp"
+
+template class Graph<PRValue>;
+template class GraphUtil<PRValue, double>;
+
+template class PageRank<PRValue, double>;
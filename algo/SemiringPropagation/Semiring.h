@@ -0,0 +1,92 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_SEMIRING_H
+#define GRAPH_ALGO_SEMIRING_H
+
+#include <cstdint>
+#include <cmath>
+#include <limits>
+
+//Semirings of SemiringPropagation, each of which gives (all static, so that kernels are inlined)
+//zero(): identity of combine, the value of unreached lanes and the absence of a message
+//one(): the value of the lane of an initV to itself
+//combine(a, b): merge of two values (or messages) of the same lane
+//extend(a, weight): value of a propagated along an edge
+//delta(value, propagated): what is propagated again by a lane which was propagated with the value propagated before
+//isChanged(value, old): whether a lane changed enough to be propagated again
+
+//Shortest path
+template <typename T>
+class MinPlusSemiring
+{
+public:
+    static T zero() {return (T)(INT32_MAX >> 1);}
+    static T one() {return (T)0;}
+    static T combine(T a, T b) {return a < b ? a : b;}
+    static T extend(T a, double weight) {return a + (T)weight;}
+    static T delta(T value, T propagated) {return value;}
+    static bool isChanged(T value, T old) {return value != old;}
+};
+
+//Widest (bottleneck) path, weights are capacities
+template <typename T>
+class MaxMinSemiring
+{
+public:
+    static T zero() {return std::numeric_limits<T>::lowest();}
+    static T one() {return std::numeric_limits<T>::max();}
+    static T combine(T a, T b) {return a > b ? a : b;}
+    static T extend(T a, double weight) {return a < (T)weight ? a : (T)weight;}
+    static T delta(T value, T propagated) {return value;}
+    static bool isChanged(T value, T old) {return value != old;}
+};
+
+//Most reliable path, weights are probabilities in [0, 1]
+template <typename T>
+class MaxTimesSemiring
+{
+public:
+    static T zero() {return (T)0;}
+    static T one() {return (T)1;}
+    static T combine(T a, T b) {return a > b ? a : b;}
+    static T extend(T a, double weight) {return a * (T)weight;}
+    static T delta(T value, T propagated) {return value;}
+    static bool isChanged(T value, T old) {return value != old;}
+};
+
+//Reachability, weights are ignored
+template <typename T>
+class BooleanSemiring
+{
+public:
+    static T zero() {return (T)0;}
+    static T one() {return (T)1;}
+    static T combine(T a, T b) {return a || b ? (T)1 : (T)0;}
+    static T extend(T a, double weight) {return a;}
+    static T delta(T value, T propagated) {return value;}
+    static bool isChanged(T value, T old) {return value != old;}
+};
+
+//Changes below it are not propagated by SumSemiring
+#define SEMIRING_SUM_EPSILON 1e-7
+
+//Sum of weighted walks (PageRank-style jobs: weights are damping / out-degree of src)
+//Not idempotent, so only increments since the last propagation are propagated again
+//The sum over walks should converge, e.g. with weights of every out-edge set summing below 1
+template <typename T>
+class SumSemiring
+{
+public:
+    static T zero() {return (T)0;}
+    static T one() {return (T)1;}
+    static T combine(T a, T b) {return a + b;}
+    static T extend(T a, double weight) {return a * (T)weight;}
+    static T delta(T value, T propagated) {return value - propagated;}
+    static bool isChanged(T value, T old) {return std::fabs((double)(value - old)) > SEMIRING_SUM_EPSILON;}
+};
+
+#endif //GRAPH_ALGO_SEMIRING_H
@@ -0,0 +1,348 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "SemiringPropagation.h"
+
+#include <iostream>
+#include <ctime>
+
+template <typename VertexValueType, typename SemiringType>
+SemiringPropagation<VertexValueType, SemiringType>::SemiringPropagation()
+{
+    this->numOfInitV = 0;
+}
+
+template <typename VertexValueType, typename SemiringType>
+int SemiringPropagation<VertexValueType, SemiringType>::MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<VertexValueType> &mSet)
+{
+    //Activity reset
+    activeVertice.clear();
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //MSG Init
+    auto mValues = std::vector<VertexValueType>(g.vCount * this->numOfInitV, SemiringType::zero());
+    for(const auto &m : mSet.mSet)
+    {
+        auto &mv = mValues.at(m.dst * this->numOfInitV + g.vList.at(m.src).initVIndex);
+        mv = SemiringType::combine(mv, m.value);
+    }
+
+    //array form computation
+    this->MSGApply_array(g.vCount, g.eCount, &g.vList[0], this->numOfInitV, &initVSet[0], &g.verticesValue[0], &mValues[0]);
+
+    //Active vertices set assembly
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(g.vList.at(i).isActive)
+            activeVertice.insert(i);
+    }
+
+    return activeVertice.size();
+}
+
+template <typename VertexValueType, typename SemiringType>
+int SemiringPropagation<VertexValueType, SemiringType>::MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<VertexValueType> &mSet)
+{
+    //Generate merged msgs directly
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //mValues init
+    auto mValues = std::vector<VertexValueType>(g.vCount * this->numOfInitV);
+
+    //array form computation
+    this->MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], &g.eList[0], this->numOfInitV, &initVSet[0], &g.verticesValue[0], &mValues[0]);
+
+    //Package mMergedMSGValueSet to result mSet
+    for(int i = 0; i < g.vCount * this->numOfInitV; i++)
+    {
+        if(mValues.at(i) != SemiringType::zero())
+        {
+            int dst = i / this->numOfInitV;
+            int initV = initVSet[i % this->numOfInitV];
+            mSet.insertMsg(Message<VertexValueType>(initV, dst, mValues.at(i)));
+        }
+    }
+
+    return mSet.mSet.size();
+}
+
+template <typename VertexValueType, typename SemiringType>
+int SemiringPropagation<VertexValueType, SemiringType>::MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, VertexValueType *mValues)
+{
+    int avCount = 0;
+
+    for(int i = 0; i < vCount; i++) vSet[i].isActive = false;
+
+    for(int i = 0; i < vCount * numOfInitV; i++)
+    {
+        auto value = SemiringType::combine(vValues[i], mValues[i]);
+        if(SemiringType::isChanged(value, vValues[i]))
+        {
+            if(!vSet[i / numOfInitV].isActive)
+            {
+                vSet[i / numOfInitV].isActive = true;
+                avCount++;
+            }
+        }
+        vValues[i] = value;
+    }
+
+    return avCount;
+}
+
+template <typename VertexValueType, typename SemiringType>
+int SemiringPropagation<VertexValueType, SemiringType>::MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, VertexValueType *mValues)
+{
+    for(int i = 0; i < vCount * numOfInitV; i++) mValues[i] = SemiringType::zero();
+
+    auto &propagated = this->propagatedValueSet[eSet];
+    if(propagated.size() != vCount * numOfInitV) propagated.assign(vCount * numOfInitV, SemiringType::zero());
+
+    //Lane mask & delta build
+    int wordCount = (numOfInitV + 63) >> 6;
+    this->laneMask.assign(vCount * wordCount, 0);
+    this->laneDelta.resize(vCount * numOfInitV);
+    for(int i = 0; i < vCount; i++)
+    {
+        if(!vSet[i].isActive) continue;
+
+        for(int j = 0; j < numOfInitV; j++)
+        {
+            auto value = vValues[i * numOfInitV + j];
+            auto &propagatedValue = propagated[i * numOfInitV + j];
+            if(SemiringType::isChanged(value, propagatedValue))
+            {
+                this->laneMask[i * wordCount + (j >> 6)] |= 1ULL << (j & 63);
+                this->laneDelta[i * numOfInitV + j] = SemiringType::delta(value, propagatedValue);
+                propagatedValue = value;
+            }
+        }
+    }
+
+    for(int i = 0; i < eCount; i++)
+    {
+        const auto &e = eSet[i];
+        if(!vSet[e.src].isActive) continue;
+
+        //Only changed lanes of src are propagated
+        for(int k = 0; k < wordCount; k++)
+        {
+            auto bits = this->laneMask[e.src * wordCount + k];
+            while(bits)
+            {
+                int j = (k << 6) + __builtin_ctzll(bits);
+                bits &= bits - 1;
+
+                auto &mv = mValues[e.dst * numOfInitV + j];
+                mv = SemiringType::combine(mv, SemiringType::extend(this->laneDelta[e.src * numOfInitV + j], e.weight));
+            }
+        }
+    }
+
+    return vCount * numOfInitV;
+}
+
+template <typename VertexValueType, typename SemiringType>
+bool SemiringPropagation<VertexValueType, SemiringType>::isMSGMergeable()
+{
+    return true;
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::MSGMerge_array(int vCount, int numOfInitV, VertexValueType *mValues, const VertexValueType *mValuesOther)
+{
+    for(int i = 0; i < vCount * numOfInitV; i++)
+        mValues[i] = SemiringType::combine(mValues[i], mValuesOther[i]);
+}
+
+template <typename VertexValueType, typename SemiringType>
+bool SemiringPropagation<VertexValueType, SemiringType>::isApplyVertexLocal()
+{
+    return true;
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::ResetRunState()
+{
+    this->propagatedValueSet.clear();
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::Init(int vCount, int eCount, int numOfInitV)
+{
+    this->numOfInitV = numOfInitV;
+
+    //Memory parameter init
+    this->totalVValuesCount = vCount * numOfInitV;
+    this->totalMValuesCount = vCount * numOfInitV;
+    this->propagatedValueSet.clear();
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList)
+{
+    int numOfInitV_init = initVList.size();
+
+    //v Init
+    for(int i = 0; i < numOfInitV_init; i++)
+        g.vList.at(initVList.at(i)).initVIndex = i;
+    for(auto &v : g.vList)
+    {
+        if(v.initVIndex != INVALID_INITV_INDEX)
+        {
+            activeVertices.insert(v.vertexID);
+            v.isActive = true;
+        }
+        else v.isActive = false;
+    }
+
+    //vValues init
+    g.verticesValue.assign(g.vCount * numOfInitV_init, SemiringType::zero());
+    for(int initID : initVList)
+        g.verticesValue.at(initID * numOfInitV_init + g.vList.at(initID).initVIndex) = SemiringType::one();
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::Deploy(int vCount, int eCount, int numOfInitV)
+{
+
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::Free()
+{
+    this->propagatedValueSet.clear();
+    this->laneMask.clear();
+    this->laneDelta.clear();
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                const std::vector<int> &initVList)
+{
+    //Init
+    activeVertices.clear();
+    for(auto &v : g.vList) v.isActive = false;
+
+    //Every subgraph started from the values of g, so what it changed is its delta from them
+    //(the subgraph value itself for idempotent semirings, and the increment for SumSemiring)
+    auto merged = g.verticesValue;
+
+    //Merge graphs
+    for(const auto &subG : subGSet)
+    {
+        //vSet merge
+        for(int i = 0; i < subG.vCount; i++)
+            g.vList.at(i).isActive |= subG.vList.at(i).isActive;
+
+        //vValues merge
+        for(int i = 0; i < subG.verticesValue.size(); i++)
+            merged.at(i) = SemiringType::combine(merged.at(i), SemiringType::delta(subG.verticesValue.at(i), g.verticesValue.at(i)));
+    }
+
+    g.verticesValue = merged;
+
+    //Merge active vertices set
+    for(const auto &AVs : activeVerticeSet)
+    {
+        for(auto av : AVs)
+            activeVertices.insert(av);
+    }
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices)
+{
+    auto mMergedSet = MessageSet<VertexValueType>();
+
+    MSGGenMerge(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "MGenMerge:" << clock() << std::endl;
+    //Test end
+
+    activeVertices.clear();
+    MSGApply(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "Apply:" << clock() << std::endl;
+    //Test end
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    while(activeVertices.size() > 0)
+        ApplyStep(g, initVList, activeVertices);
+
+    Free();
+}
+
+template <typename VertexValueType, typename SemiringType>
+void SemiringPropagation<VertexValueType, SemiringType>::ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    std::vector<std::set<int>> AVSet = std::vector<std::set<int>>(partitionCount);
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    //Subgraphs are divided only once, so that every edge set keeps its propagated lane values
+    auto subGraphSet = this->DivideGraphByEdge(g, partitionCount);
+
+    int iterCount = 0;
+
+    while(activeVertices.size() > 0)
+    {
+        //Test
+        std::cout << ++iterCount << ":" << clock() << std::endl;
+        //Test end
+
+        for(int i = 0; i < partitionCount; i++)
+        {
+            auto &subG = subGraphSet.at(i);
+            subG.verticesValue = g.verticesValue;
+            for(int j = 0; j < g.vCount; j++) subG.vList.at(j).isActive = g.vList.at(j).isActive;
+            AVSet.at(i) = activeVertices;
+        }
+
+        //Test
+        std::cout << "GDivide:" << clock() << std::endl;
+        //Test end
+
+        for(int i = 0; i < partitionCount; i++)
+            ApplyStep(subGraphSet.at(i), initVList, AVSet.at(i));
+
+        activeVertices.clear();
+        MergeGraph(g, subGraphSet, activeVertices, AVSet, initVList);
+        //Test
+        std::cout << "GMerge:" << clock() << std::endl;
+        //Test end
+    }
+
+    Free();
+
+    //Test
+    std::cout << "end" << ":" << clock() << std::endl;
+    //Test end
+}
@@ -0,0 +1,73 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_SEMIRINGPROPAGATION_H
+#define GRAPH_ALGO_SEMIRINGPROPAGATION_H
+
+#include "../../core/GraphUtil.h"
+#include "Semiring.h"
+
+#include <cstdint>
+
+//Gen/merge/apply loop of path problems over a semiring (see Semiring.h), one lane per (vertex, initV)
+//Lane of v for initV is the combine over all paths from initV to v of one() extended along the path
+//vValues[v * numOfInitV + j] are lane values, and mValues are combined messages (zero() if none)
+template <typename VertexValueType, typename SemiringType>
+class SemiringPropagation : public GraphUtil<VertexValueType, VertexValueType>
+{
+public:
+    SemiringPropagation();
+
+    int MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<VertexValueType> &mSet) override;
+    int MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<VertexValueType> &mSet) override;
+
+    int MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, VertexValueType *mValues) override;
+    int MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, VertexValueType *mValues) override;
+
+    bool isMSGMergeable() override;
+    void MSGMerge_array(int vCount, int numOfInitV, VertexValueType *mValues, const VertexValueType *mValuesOther) override;
+    bool isApplyVertexLocal() override;
+    void ResetRunState() override;
+
+    void MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                    std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                    const std::vector<int> &initVList) override;
+
+    void Init(int vCount, int eCount, int numOfInitV) override;
+    void GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList) override;
+    void Deploy(int vCount, int eCount, int numOfInitV) override;
+    void Free() override;
+
+    void ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices);
+    void Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList);
+
+    void ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount);
+
+protected:
+    int numOfInitV;
+
+    //Values of every lane when they were last propagated along each edge set, dropped for a new run
+    //Deltas of Sum are taken against them, so that stale ones would make sums wrong rather than only unrelaxed
+    std::map<const Edge *, std::vector<VertexValueType>> propagatedValueSet;
+    //Changed lanes of every active vertex in this superstep, one bit per initV
+    std::vector<uint64_t> laneMask;
+    //What changed lanes propagate in this superstep (SemiringType::delta)
+    std::vector<VertexValueType> laneDelta;
+};
+
+//Common instances
+template <typename VertexValueType>
+using ShortestPath = SemiringPropagation<VertexValueType, MinPlusSemiring<VertexValueType>>;
+template <typename VertexValueType>
+using WidestPath = SemiringPropagation<VertexValueType, MaxMinSemiring<VertexValueType>>;
+template <typename VertexValueType>
+using MostReliablePath = SemiringPropagation<VertexValueType, MaxTimesSemiring<VertexValueType>>;
+template <typename VertexValueType>
+using Reachability = SemiringPropagation<VertexValueType, BooleanSemiring<VertexValueType>>;
+template <typename VertexValueType>
+using WalkSum = SemiringPropagation<VertexValueType, SumSemiring<VertexValueType>>;
+
+#endif //GRAPH_ALGO_SEMIRINGPROPAGATION_H
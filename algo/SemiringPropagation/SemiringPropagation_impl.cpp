@@ -0,0 +1,13 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "SemiringPropagation.cpp"
+
+template class SemiringPropagation<double, MinPlusSemiring<double>>;
+template class SemiringPropagation<int, MinPlusSemiring<int>>;
+template class SemiringPropagation<double, MaxMinSemiring<double>>;
+template class SemiringPropagation<int, MaxMinSemiring<int>>;
+template class SemiringPropagation<double, MaxTimesSemiring<double>>;
+template class SemiringPropagation<int, BooleanSemiring<int>>;
+template class SemiringPropagation<double, SumSemiring<double>>;
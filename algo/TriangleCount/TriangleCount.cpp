@@ -0,0 +1,468 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "TriangleCount.h"
+
+#include <iostream>
+#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+TCOrientedIndex::TCOrientedIndex()
+{
+    this->vCount = -1;
+    this->degree = std::vector<int>();
+    this->rank = std::vector<int>();
+    this->order = std::vector<int>();
+    this->offset = std::vector<int>();
+    this->adj = std::vector<int>();
+}
+
+//Lists whose lengths differ more than this ratio are intersected by galloping the shorter one
+#define TC_GALLOP_RATIO 32
+//Oriented edges taken by a thread at a time
+#define TC_CHUNK_SIZE 256
+
+//Calls onMatch(x) for every x in both sorted lists a[0 .. na) and b[0 .. nb), and returns the count of them
+template <typename F>
+static inline int intersectSorted(const int *a, int na, const int *b, int nb, F &&onMatch)
+{
+    int count = 0;
+
+    if(na * TC_GALLOP_RATIO < nb || nb * TC_GALLOP_RATIO < na)
+    {
+        if(na > nb) {std::swap(a, b); std::swap(na, nb);}
+
+        const int *cursor = b;
+        for(int i = 0; i < na && cursor < b + nb; i++)
+        {
+            cursor = std::lower_bound(cursor, b + nb, a[i]);
+            if(cursor < b + nb && *cursor == a[i]) {onMatch(a[i]); count++;}
+        }
+
+        return count;
+    }
+
+    int i = 0, j = 0;
+
+#if defined(__SSE2__)
+    //Every 4 elements of a are compared with all rotations of 4 elements of b
+    while(i + 4 <= na && j + 4 <= nb)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        while(mask)
+        {
+            onMatch(a[i + __builtin_ctz(mask)]);
+            count++;
+            mask &= mask - 1;
+        }
+
+        int aMax = a[i + 3], bMax = b[j + 3];
+        if(aMax <= bMax) i += 4;
+        if(bMax <= aMax) j += 4;
+    }
+#endif
+
+    while(i < na && j < nb)
+    {
+        if(a[i] < b[j]) i++;
+        else if(a[i] > b[j]) j++;
+        else
+        {
+            onMatch(a[i]);
+            count++;
+            i++;
+            j++;
+        }
+    }
+
+    return count;
+}
+
+//Sorts pairs (first in [0, vCount)) and removes duplicated ones
+//Counting sort by first keeps every later sort within the list of one vertex
+static void sortUniquePairs(int vCount, std::vector<std::pair<int, int>> &pairs)
+{
+    auto offset = std::vector<int>(vCount + 1, 0);
+    for(const auto &p : pairs) offset.at(p.first + 1)++;
+    for(int i = 0; i < vCount; i++) offset.at(i + 1) += offset.at(i);
+
+    auto cursor = std::vector<int>(offset.begin(), offset.end() - 1);
+    auto second = std::vector<int>(pairs.size());
+    for(const auto &p : pairs) second.at(cursor.at(p.first)++) = p.second;
+
+    size_t count = 0;
+    for(int i = 0; i < vCount; i++)
+    {
+        auto begin = second.begin() + offset.at(i), end = second.begin() + offset.at(i + 1);
+        std::sort(begin, end);
+        end = std::unique(begin, end);
+        for(auto it = begin; it != end; it++) pairs.at(count++) = std::make_pair(i, *it);
+    }
+    pairs.resize(count);
+}
+
+static inline double clusteringCoefficientOf(int degree, long long triangleCount)
+{
+    return degree > 1 ? 2.0 * triangleCount / ((double)degree * (degree - 1)) : 0;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+TriangleCount<VertexValueType, MessageValueType>::TriangleCount()
+{
+    this->threadCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int TriangleCount<VertexValueType, MessageValueType>::MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet)
+{
+    //Activity reset
+    activeVertice.clear();
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //MSG Init
+    auto mValues = std::vector<MessageValueType>(g.vCount, (MessageValueType)0);
+    for(const auto &m : mSet.mSet) mValues.at(m.dst) += m.value;
+
+    //array form computation
+    this->MSGApply_array(g.vCount, g.eCount, &g.vList[0], this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Active vertices set assembly
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(g.vList.at(i).isActive)
+            activeVertice.insert(i);
+    }
+
+    return activeVertice.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int TriangleCount<VertexValueType, MessageValueType>::MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet)
+{
+    //Generate merged msgs directly
+
+    //Availability check
+    if(g.vCount <= 0) return 0;
+
+    //mValues init
+    auto mValues = std::vector<MessageValueType>(g.vCount, (MessageValueType)0);
+
+    //array form computation
+    this->MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], g.eList.data(), this->numOfInitV, initVSet.data(), &g.verticesValue[0], &mValues[0]);
+
+    //Package merged msg of each vertex to result mSet
+    mSet.mSet.clear();
+    for(int i = 0; i < g.vCount; i++)
+    {
+        if(mValues.at(i) != (MessageValueType)0)
+            mSet.insertMsg(Message<MessageValueType>(i, i, mValues.at(i)));
+    }
+
+    return mSet.mSet.size();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int TriangleCount<VertexValueType, MessageValueType>::MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues)
+{
+    //Triangles are counted in one superstep
+    for(int i = 0; i < vCount; i++)
+    {
+        vValues[i].triangleCount = (long long)mValues[i];
+        vValues[i].clusteringCoefficient = clusteringCoefficientOf(vValues[i].degree, vValues[i].triangleCount);
+        vSet[i].isActive = false;
+    }
+
+    return 0;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int TriangleCount<VertexValueType, MessageValueType>::MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues)
+{
+    if(this->index.vCount != vCount) this->buildIndex(vCount, eCount, eSet);
+    const auto &index = this->index;
+
+    //Oriented & deduplicated edges of eSet
+    auto work = std::vector<std::pair<int, int>>();
+    work.reserve(eCount);
+    for(int i = 0; i < eCount; i++)
+    {
+        if(eSet[i].src == eSet[i].dst) continue;
+        int ru = index.rank[eSet[i].src], rv = index.rank[eSet[i].dst];
+        work.emplace_back(std::min(ru, rv), std::max(ru, rv));
+    }
+    sortUniquePairs(vCount, work);
+
+    //Every triangle (ru < rv < rw) is found once, by its edge (ru, rv)
+    //Threads take chunks of edges dynamically so that edges of hubs don't stall one thread, and count by rank into their own arrays
+    int threadCount = std::max(1, std::min(this->threadCount, (int)(work.size() / TC_CHUNK_SIZE) + 1));
+    auto counts = std::vector<std::vector<long long>>(threadCount, std::vector<long long>(vCount, 0));
+    std::atomic<size_t> next(0);
+
+    auto countChunks = [&](int t)
+    {
+        auto &count = counts.at(t);
+        for(size_t begin = next.fetch_add(TC_CHUNK_SIZE); begin < work.size(); begin = next.fetch_add(TC_CHUNK_SIZE))
+        {
+            for(size_t k = begin; k < std::min(begin + TC_CHUNK_SIZE, work.size()); k++)
+            {
+                int ru = work[k].first, rv = work[k].second;
+
+                //Neighbors of ru not higher than rv can't close a triangle with (ru, rv)
+                const int *a = std::upper_bound(index.adj.data() + index.offset[ru], index.adj.data() + index.offset[ru + 1], rv);
+                int na = (int)(index.adj.data() + index.offset[ru + 1] - a);
+                const int *b = index.adj.data() + index.offset[rv];
+                int nb = index.offset[rv + 1] - index.offset[rv];
+
+                int c = intersectSorted(a, na, b, nb, [&count](int rw) {count[rw]++;});
+                count[ru] += c;
+                count[rv] += c;
+            }
+        }
+    };
+
+    if(!work.empty())
+    {
+        auto threads = std::vector<std::thread>();
+        for(int t = 1; t < threadCount; t++) threads.emplace_back(countChunks, t);
+        countChunks(0);
+        for(auto &th : threads) th.join();
+    }
+
+    for(int i = 0; i < vCount; i++)
+    {
+        long long sum = 0;
+        for(const auto &count : counts) sum += count[index.rank[i]];
+        mValues[i] = (MessageValueType)sum;
+    }
+
+    return vCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void TriangleCount<VertexValueType, MessageValueType>::Init(int vCount, int eCount, int numOfInitV)
+{
+    this->numOfInitV = numOfInitV;
+
+    //Memory parameter init
+    this->totalVValuesCount = vCount;
+    this->totalMValuesCount = vCount;
+
+    this->index = TCOrientedIndex();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void TriangleCount<VertexValueType, MessageValueType>::GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList)
+{
+    this->buildIndex(g.vCount, g.eCount, g.eList.data());
+
+    //vValues init
+    g.verticesValue.assign(g.vCount, VertexValueType());
+    for(int i = 0; i < g.vCount; i++) g.verticesValue.at(i).degree = this->index.degree.at(i);
+
+    //Every vertex is active at first
+    for(auto &v : g.vList)
+    {
+        v.isActive = true;
+        activeVertices.insert(v.vertexID);
+    }
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void TriangleCount<VertexValueType, MessageValueType>::Deploy(int vCount, int eCount, int numOfInitV)
+{
+
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void TriangleCount<VertexValueType, MessageValueType>::Free()
+{
+    this->index = TCOrientedIndex();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void TriangleCount<VertexValueType, MessageValueType>::MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                const std::vector<int> &initVList)
+{
+    //Triangle count merge
+    for(int i = 0; i < g.vCount; i++)
+    {
+        auto &vV = g.verticesValue.at(i);
+        vV.triangleCount = 0;
+        for(const auto &subG : subGSet) vV.triangleCount += subG.verticesValue.at(i).triangleCount;
+        vV.clusteringCoefficient = clusteringCoefficientOf(vV.degree, vV.triangleCount);
+        g.vList.at(i).isActive = false;
+    }
+
+    activeVertices.clear();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void TriangleCount<VertexValueType, MessageValueType>::buildIndex(int vCount, int eCount, const Edge *eSet)
+{
+    auto &index = this->index;
+    index.vCount = vCount;
+
+    //Undirected & deduplicated edges
+    auto edges = std::vector<std::pair<int, int>>();
+    edges.reserve(eCount);
+    for(int i = 0; i < eCount; i++)
+    {
+        if(eSet[i].src == eSet[i].dst) continue;
+        edges.emplace_back(std::min(eSet[i].src, eSet[i].dst), std::max(eSet[i].src, eSet[i].dst));
+    }
+    sortUniquePairs(vCount, edges);
+
+    index.degree.assign(vCount, 0);
+    for(const auto &e : edges)
+    {
+        index.degree.at(e.first)++;
+        index.degree.at(e.second)++;
+    }
+
+    //Rank by (degree, vertexID)
+    index.order.resize(vCount);
+    for(int i = 0; i < vCount; i++) index.order.at(i) = i;
+    std::sort(index.order.begin(), index.order.end(), [&index](int a, int b)
+    {
+        return index.degree.at(a) != index.degree.at(b) ? index.degree.at(a) < index.degree.at(b) : a < b;
+    });
+    index.rank.resize(vCount);
+    for(int i = 0; i < vCount; i++) index.rank.at(index.order.at(i)) = i;
+
+    //Counting sort of oriented edges by lower rank
+    index.offset.assign(vCount + 1, 0);
+    for(const auto &e : edges) index.offset.at(std::min(index.rank.at(e.first), index.rank.at(e.second)) + 1)++;
+    for(int i = 0; i < vCount; i++) index.offset.at(i + 1) += index.offset.at(i);
+
+    auto cursor = std::vector<int>(index.offset.begin(), index.offset.end() - 1);
+    index.adj.resize(edges.size());
+    for(const auto &e : edges)
+    {
+        int ru = index.rank.at(e.first), rv = index.rank.at(e.second);
+        if(ru > rv) std::swap(ru, rv);
+        index.adj.at(cursor.at(ru)++) = rv;
+    }
+
+    for(int i = 0; i < vCount; i++)
+        std::sort(index.adj.begin() + index.offset.at(i), index.adj.begin() + index.offset.at(i + 1));
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void TriangleCount<VertexValueType, MessageValueType>::ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices)
+{
+    auto mMergedSet = MessageSet<MessageValueType>();
+
+    mMergedSet.mSet.clear();
+    MSGGenMerge(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "MGenMerge:" << clock() << std::endl;
+    //Test end
+
+    activeVertices.clear();
+    MSGApply(g, initVSet, activeVertices, mMergedSet);
+
+    //Test
+    std::cout << "Apply:" << clock() << std::endl;
+    //Test end
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void TriangleCount<VertexValueType, MessageValueType>::Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    while(activeVertices.size() > 0)
+        ApplyStep(g, initVList, activeVertices);
+
+    Free();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void TriangleCount<VertexValueType, MessageValueType>::ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount)
+{
+    //Init the Graph
+    std::set<int> activeVertices = std::set<int>();
+
+    Init(g.vCount, g.eCount, initVList.size());
+
+    GraphInit(g, activeVertices, initVList);
+
+    Deploy(g.vCount, g.eCount, initVList.size());
+
+    //Divide oriented edges by their lower ranked ends
+    //An edge (ru, rv) costs about the lengths of both adjacency lists, and every subgraph gets consecutive ranks of about the same cost
+    const auto &index = this->index;
+    long long totalCost = 0;
+    for(int ru = 0; ru < g.vCount; ru++)
+    {
+        for(int k = index.offset.at(ru); k < index.offset.at(ru + 1); k++)
+            totalCost += 1 + (index.offset.at(ru + 1) - index.offset.at(ru)) + (index.offset.at(index.adj.at(k) + 1) - index.offset.at(index.adj.at(k)));
+    }
+
+    auto subGraphSet = std::vector<Graph<VertexValueType>>();
+    for(int i = 0; i < partitionCount; i++) subGraphSet.push_back(Graph<VertexValueType>(g.vList, std::vector<Edge>(), g.verticesValue));
+
+    long long cost = 0;
+    for(int ru = 0; ru < g.vCount; ru++)
+    {
+        int i = totalCost > 0 ? (int)std::min((long long)partitionCount - 1, cost * partitionCount / totalCost) : 0;
+        for(int k = index.offset.at(ru); k < index.offset.at(ru + 1); k++)
+        {
+            subGraphSet.at(i).insertEdge(index.order.at(ru), index.order.at(index.adj.at(k)), 1);
+            cost += 1 + (index.offset.at(ru + 1) - index.offset.at(ru)) + (index.offset.at(index.adj.at(k) + 1) - index.offset.at(index.adj.at(k)));
+        }
+    }
+
+    std::vector<std::set<int>> AVSet = std::vector<std::set<int>>();
+    for(int i = 0; i < partitionCount; i++) AVSet.push_back(activeVertices);
+
+    int iterCount = 0;
+
+    while(activeVertices.size() > 0)
+    {
+        //Test
+        std::cout << ++iterCount << ":" << clock() << std::endl;
+        //Test end
+
+        for(int i = 0; i < partitionCount; i++)
+            ApplyStep(subGraphSet.at(i), initVList, AVSet.at(i));
+
+        MergeGraph(g, subGraphSet, activeVertices, AVSet, initVList);
+
+        //Test
+        std::cout << "GMerge:" << clock() << std::endl;
+        //Test end
+    }
+
+    Free();
+
+    //Test
+    std::cout << "end" << ":" << clock() << std::endl;
+    //Test end
+}
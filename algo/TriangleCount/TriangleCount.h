@@ -0,0 +1,99 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_TRIANGLECOUNT_H
+#define GRAPH_ALGO_TRIANGLECOUNT_H
+
+#include "../../core/GraphUtil.h"
+
+#include <type_traits>
+
+//Triangle count value class definition
+//Edges are taken as undirected, and self loops & duplicated edges are ignored
+class TCValue
+{
+public:
+    TCValue() : TCValue(0, 0, 0)
+    {
+
+    }
+
+    TCValue(int degree, long long triangleCount, double clusteringCoefficient)
+    {
+        this->degree = degree;
+        this->triangleCount = triangleCount;
+        this->clusteringCoefficient = clusteringCoefficient;
+    }
+
+    //Degree in the whole (undirected, deduplicated) graph
+    int degree;
+    //Triangles containing this vertex
+    //Only a part of the count in a subgraph, which is completed by MergeGraph (or the client)
+    long long triangleCount;
+    double clusteringCoefficient;
+};
+
+static_assert(std::is_trivially_copyable<TCValue>::value, "TCValue should be able to be copied into shared memory directly");
+
+//Degree-ordered adjacency of the whole graph
+//Vertices are ranked by (degree, vertexID), and every undirected edge is kept once at its lower ranked end
+//so that no adjacency list is longer than O(sqrt(eCount)), hubs included
+class TCOrientedIndex
+{
+public:
+    TCOrientedIndex();
+
+    int vCount;
+    std::vector<int> degree;
+    //rank[vid] and order[rank]
+    std::vector<int> rank;
+    std::vector<int> order;
+    //Higher ranked neighbors of every rank, sorted
+    std::vector<int> offset;
+    std::vector<int> adj;
+};
+
+template <typename VertexValueType, typename MessageValueType>
+class TriangleCount : public GraphUtil<VertexValueType, MessageValueType>
+{
+public:
+    TriangleCount();
+
+    int MSGApply(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertice, const MessageSet<MessageValueType> &mSet) override;
+    int MSGGenMerge(const Graph<VertexValueType> &g, const std::vector<int> &initVSet, const std::set<int> &activeVertice, MessageSet<MessageValueType> &mSet) override;
+
+    //mValues[v] is the count of triangles containing v which are closed by edges of eSet
+    int MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues) override;
+    int MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues) override;
+
+    void MergeGraph(Graph<VertexValueType> &g, const std::vector<Graph<VertexValueType>> &subGSet,
+                    std::set<int> &activeVertices, const std::vector<std::set<int>> &activeVerticeSet,
+                    const std::vector<int> &initVList) override;
+
+    void Init(int vCount, int eCount, int numOfInitV) override;
+    void GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList) override;
+    void Deploy(int vCount, int eCount, int numOfInitV) override;
+    void Free() override;
+
+    void ApplyStep(Graph<VertexValueType> &g, const std::vector<int> &initVSet, std::set<int> &activeVertices);
+    void Apply(Graph<VertexValueType> &g, const std::vector<int> &initVList);
+
+    //Subgraphs are divided by the lower ranked end of every undirected edge, balanced by intersection work
+    void ApplyD(Graph<VertexValueType> &g, const std::vector<int> &initVList, int partitionCount);
+
+    //Threads used by MSGGenMerge_array
+    int threadCount;
+
+protected:
+    int numOfInitV;
+
+    //Built by GraphInit from the whole graph, or by MSGGenMerge_array from eSet if GraphInit is not called (eSet is the whole graph then)
+    TCOrientedIndex index;
+
+    void buildIndex(int vCount, int eCount, const Edge *eSet);
+};
+
+#endif //GRAPH_ALGO_TRIANGLECOUNT_H
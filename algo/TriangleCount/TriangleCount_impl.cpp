@@ -0,0 +1,17 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "TriangleCount.cpp"
+
+//TCValue is defined in algo_TriangleCount and counts are not a msg type of core, so the core templates are instantiated here
+#include "../../core/Graph.cpp"
+#include "../../core/MessageSet.cpp"
+#include "../../core/GraphUtil.cpp"
+
+template class Graph<TCValue>;
+template class Message<long long>;
+template class MessageSet<long long>;
+template class GraphUtil<TCValue, long long>;
+
+template class TriangleCount<TCValue, long long>;
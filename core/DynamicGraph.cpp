@@ -0,0 +1,165 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../core/DynamicGraph.h"
+
+#include <algorithm>
+
+static bool edgeLess(const Edge &a, const Edge &b)
+{
+    return a.src != b.src ? a.src < b.src : a.dst < b.dst;
+}
+
+DynamicGraph::DynamicGraph(int vCount)
+{
+    this->vCount = vCount;
+    this->eCount = 0;
+    this->compactRatio = 0.25;
+
+    auto edges = std::vector<Edge>();
+    this->buildBase(edges);
+}
+
+DynamicGraph::DynamicGraph(const AbstractGraph &g)
+{
+    this->vCount = g.vCount;
+    this->eCount = g.eCount;
+    this->compactRatio = 0.25;
+
+    auto edges = g.eList;
+    this->buildBase(edges);
+}
+
+void DynamicGraph::buildBase(std::vector<Edge> &edges)
+{
+    std::stable_sort(edges.begin(), edges.end(), edgeLess);
+
+    this->offset.assign(this->vCount + 1, 0);
+    for(const auto &e : edges) this->offset.at(e.src + 1)++;
+    for(int i = 0; i < this->vCount; i++) this->offset.at(i + 1) += this->offset.at(i);
+
+    this->dst.resize(edges.size());
+    this->weight.resize(edges.size());
+    for(int i = 0; i < edges.size(); i++)
+    {
+        this->dst.at(i) = edges.at(i).dst;
+        this->weight.at(i) = edges.at(i).weight;
+    }
+    this->isDeleted.assign(edges.size(), false);
+    this->tombstoneCount = 0;
+
+    this->delta.assign(this->vCount, std::vector<Edge>());
+    this->deltaCount = 0;
+}
+
+void DynamicGraph::insertEdges(const std::vector<Edge> &edges)
+{
+    auto batch = edges;
+    std::stable_sort(batch.begin(), batch.end(), edgeLess);
+
+    //Every delta segment is merged with its part of the batch, so that it stays sorted
+    for(int i = 0; i < batch.size(); )
+    {
+        int src = batch.at(i).src;
+        int j = i;
+        while(j < batch.size() && batch.at(j).src == src) j++;
+
+        auto &d = this->delta.at(src);
+        auto mid = d.size();
+        d.insert(d.end(), batch.begin() + i, batch.begin() + j);
+        std::inplace_merge(d.begin(), d.begin() + mid, d.end(), edgeLess);
+
+        i = j;
+    }
+
+    this->eCount += batch.size();
+    this->deltaCount += batch.size();
+
+    this->compactIfNeeded();
+}
+
+int DynamicGraph::deleteEdges(const std::vector<Edge> &edges)
+{
+    int deletedCount = 0;
+
+    for(const auto &e : edges)
+    {
+        //Base segment
+        auto begin = this->dst.begin() + this->offset.at(e.src), end = this->dst.begin() + this->offset.at(e.src + 1);
+        for(auto it = std::lower_bound(begin, end, e.dst); it != end && *it == e.dst; it++)
+        {
+            auto &isDeleted = this->isDeleted.at(it - this->dst.begin());
+            if(isDeleted) continue;
+            isDeleted = true;
+            this->tombstoneCount++;
+            deletedCount++;
+        }
+
+        //Delta segment
+        auto &d = this->delta.at(e.src);
+        auto range = std::equal_range(d.begin(), d.end(), e, edgeLess);
+        int count = range.second - range.first;
+        if(count > 0)
+        {
+            d.erase(range.first, range.second);
+            this->deltaCount -= count;
+            deletedCount += count;
+        }
+    }
+
+    this->eCount -= deletedCount;
+
+    this->compactIfNeeded();
+
+    return deletedCount;
+}
+
+void DynamicGraph::compact()
+{
+    auto edges = this->getEdgeList();
+    this->buildBase(edges);
+}
+
+void DynamicGraph::compactIfNeeded()
+{
+    if(this->deltaCount + this->tombstoneCount > this->compactRatio * std::max(1, (int)this->dst.size()))
+        this->compact();
+}
+
+int DynamicGraph::outDegree(int vid) const
+{
+    int degree = this->delta.at(vid).size();
+    for(int i = this->offset.at(vid); i < this->offset.at(vid + 1); i++)
+    {
+        if(!this->isDeleted.at(i)) degree++;
+    }
+
+    return degree;
+}
+
+std::vector<Edge> DynamicGraph::getEdgeList() const
+{
+    auto edges = std::vector<Edge>();
+    edges.reserve(this->eCount);
+
+    //Merge of base & delta segments of every vertex
+    for(int v = 0; v < this->vCount; v++)
+    {
+        const auto &d = this->delta.at(v);
+        int i = this->offset.at(v), j = 0;
+        while(i < this->offset.at(v + 1) || j < d.size())
+        {
+            if(i < this->offset.at(v + 1) && this->isDeleted.at(i)) {i++; continue;}
+
+            if(j >= d.size() || (i < this->offset.at(v + 1) && this->dst.at(i) <= d.at(j).dst))
+            {
+                edges.emplace_back(v, this->dst.at(i), this->weight.at(i));
+                i++;
+            }
+            else edges.emplace_back(d.at(j++));
+        }
+    }
+
+    return edges;
+}
@@ -0,0 +1,66 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_DYNAMICGRAPH_H
+#define GRAPH_ALGO_DYNAMICGRAPH_H
+
+#include "../include/deps.h"
+#include "../core/AbstractGraph.h"
+
+//Edge store supporting batched inserts & deletes
+//Out-edges of every vertex are a segment of a CSR base and a delta segment, both sorted by dst
+//Deleted base edges are kept as tombstones, and the base is rebuilt from live edges by compact()
+//which is done automatically once delta edges & tombstones are more than compactRatio of the base
+class DynamicGraph
+{
+public:
+    DynamicGraph(int vCount);
+    DynamicGraph(const AbstractGraph &g);
+
+    //Edges may be duplicated
+    void insertEdges(const std::vector<Edge> &edges);
+    //Every edge with the same (src, dst) as one of edges is deleted, and the count of them is returned
+    int deleteEdges(const std::vector<Edge> &edges);
+    void compact();
+
+    int outDegree(int vid) const;
+    //Live edges in the order of (src, dst)
+    std::vector<Edge> getEdgeList() const;
+
+    //f(dst, weight) for every live out-edge of vid
+    template <typename F>
+    void forEachOutEdge(int vid, F &&f) const
+    {
+        for(int i = this->offset[vid]; i < this->offset[vid + 1]; i++)
+        {
+            if(!this->isDeleted[i]) f(this->dst[i], this->weight[i]);
+        }
+        for(const auto &e : this->delta[vid]) f(e.dst, e.weight);
+    }
+
+    int vCount;
+    //Count of live edges
+    int eCount;
+
+    double compactRatio;
+
+    //CSR base: out-edges of vid are [offset[vid], offset[vid + 1]) of dst, weight & isDeleted
+    std::vector<int> offset;
+    std::vector<int> dst;
+    std::vector<double> weight;
+    std::vector<char> isDeleted;
+    int tombstoneCount;
+
+    //Edges inserted since the last compaction
+    std::vector<std::vector<Edge>> delta;
+    int deltaCount;
+
+protected:
+    void buildBase(std::vector<Edge> &edges);
+    void compactIfNeeded();
+};
+
+#endif //GRAPH_ALGO_DYNAMICGRAPH_H
@@ -25,6 +25,21 @@ public:
     virtual int MSGApply_array(int vCount, int eCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues, MessageValueType *mValues) = 0;
     virtual int MSGGenMerge_array(int vCount, int eCount, const Vertex *vSet, const Edge *eSet, int numOfInitV, const int *initVSet, const VertexValueType *vValues, MessageValueType *mValues) = 0;
 
+    //For running array kernels on ranges in parallel (UtilServer), every range by its own copy of the executor
+    //If mergeable, MSGGenMerge_array can run on ranges of eSet, and MSGMerge_array combines mValuesOther from another range
+    //into mValues, both starting from the same vertex and of vCount vertices
+    virtual bool isMSGMergeable() {return false;}
+    virtual void MSGMerge_array(int vCount, int numOfInitV, MessageValueType *mValues, const MessageValueType *mValuesOther) {}
+    //If vertex local, MSGApply_array on vSet, vValues & mValues from the same vertex (of vCount vertices) is the part of the whole one
+    virtual bool isApplyVertexLocal() {return false;}
+    //If queryable, GraphInit_array sets vSet & vValues of vCount vertices for a new run from initVSet alone (QUERY_CMD of UtilServer)
+    //Lanes whose initVSet entries are negative have no source, and none of their values changes in the run
+    virtual bool isQueryable() {return false;}
+    virtual void GraphInit_array(int vCount, Vertex *vSet, int numOfInitV, const int *initVSet, VertexValueType *vValues) {}
+    //Drops states kept between supersteps of a run (such as values propagated before), since the next superstep starts a new run
+    //Done by Init for runs in the same process, and by UtilServer whenever the client writes the whole state
+    virtual void ResetRunState() {}
+
     //Master function
     virtual void Init(int vCount, int eCount, int numOfInitV) = 0;
     virtual void GraphInit(Graph<VertexValueType> &g, std::set<int> &activeVertices, const std::vector<int> &initVList) = 0;
@@ -7,6 +7,8 @@
 
 #define NODE_NUM_OFFSET 24
 #define SHM_OFFSET 16
+//Slot of a graph resident in a server, see UtilServer
+#define GRAPH_OFFSET 8
 #define MSG_TYPE_OFFSET 8
 #define MSG_OFFSET 0
 
@@ -17,9 +19,47 @@
 #define FILTEREDVCOUNT_SHM 7
 #define VSET_SHM 9
 #define ESET_SHM 10
+#define DOORBELL_SHM 11
+#define CHANGEDV_SHM 12
+#define MODIFIEDV_SHM 13
+//Segments between servers, see UtilServer::peerStep
+#define PEERMSG_SHM 14
+#define PEERVALUE_SHM 15
+#define PEERBARRIER_SHM 16
+//Graph of LOAD_CMD
+#define LOADINFO_SHM 17
 
 #define SRV_MSG_TYPE 1
 #define CLI_MSG_TYPE 2
 #define INIT_MSG_TYPE 3
 
+//Doorbell commands
+#define EXECUTE_CMD 1
+#define EXIT_CMD 2
+#define FINISHED_CMD 3
+//Supersteps run by the server alone, arg is the max count of them or RUN_UNTIL_CONVERGED
+//FINISHED_CMD of it has the count run as arg
+#define RUN_CMD 4
+#define RUN_UNTIL_CONVERGED -1
+//Like RUN_CMD, but servers exchange boundary values with each other between supersteps
+//It should be sent to every node, and FINISHED_CMD of it has -1 as arg if the executor does not support it
+#define PEER_RUN_CMD 5
+//Switches the server to the graph of slot arg, which is created or resized to the graph in the load info segment if needed
+//FINISHED_CMD of it has 0 as arg, or -1 if the graph cannot be loaded
+#define LOAD_CMD 6
+//Supersteps until converged from values set by the executor for initVSet alone (see GraphUtil::isQueryable)
+//Run by servers together as PEER_RUN_CMD if nodeCount of them is more than 1, and FINISHED_CMD of it has the count run as arg or -1
+//arg is the count of nodes of the client, which should be nodeCount of every server
+#define QUERY_CMD 7
+
+//Slots of graphs in a server
+#define MAX_GRAPH_COUNT 256
+
+typedef struct LoadInfo
+{
+    int vCount;
+    int eCount;
+    int numOfInitV;
+}LoadInfo;
+
 #endif //GRAPH_ALGO_UNIX_MARCO_H
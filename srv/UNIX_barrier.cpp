@@ -0,0 +1,86 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "UNIX_barrier.h"
+#include "UNIX_doorbell.h"
+
+#include <thread>
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+UNIX_barrier::UNIX_barrier()
+{
+    this->state_shm = UNIX_shm();
+    this->state = nullptr;
+    this->spinCount = std::thread::hardware_concurrency() > 1 ? DOORBELL_SPIN_COUNT : 0;
+}
+
+int UNIX_barrier::create(key_t key, int count, int auth)
+{
+    int ret = this->state_shm.create(key, sizeof(BarrierState), auth);
+    if(ret != -1)
+    {
+        this->state_shm.attach(auth);
+        this->state = (BarrierState *)this->state_shm.shmaddr;
+        this->state->count = count;
+    }
+
+    return ret;
+}
+
+int UNIX_barrier::fetch(key_t key)
+{
+    int ret = this->state_shm.fetch(key);
+    if(ret != -1)
+    {
+        this->state_shm.attach(0666);
+        this->state = (BarrierState *)this->state_shm.shmaddr;
+    }
+
+    return ret;
+}
+
+int UNIX_barrier::detach()
+{
+    this->state = nullptr;
+    return this->state_shm.detach();
+}
+
+int UNIX_barrier::control(int cmd)
+{
+    return this->state_shm.control(cmd);
+}
+
+void UNIX_barrier::wait()
+{
+    auto &s = *this->state;
+    int generation = __atomic_load_n(&s.generation, __ATOMIC_ACQUIRE);
+
+    //The last one resets the count before releasing the others, so the barrier can be reused at once
+    if(__atomic_add_fetch(&s.arrivedCount, 1, __ATOMIC_ACQ_REL) == s.count)
+    {
+        __atomic_store_n(&s.arrivedCount, 0, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&s.generation, 1, __ATOMIC_SEQ_CST);
+        if(__atomic_load_n(&s.waiterCount, __ATOMIC_SEQ_CST) > 0)
+            syscall(SYS_futex, &s.generation, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+        return;
+    }
+
+    for(int i = 0; i < this->spinCount && __atomic_load_n(&s.generation, __ATOMIC_ACQUIRE) == generation; i++)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    if(__atomic_load_n(&s.generation, __ATOMIC_ACQUIRE) == generation)
+    {
+        __atomic_add_fetch(&s.waiterCount, 1, __ATOMIC_SEQ_CST);
+        while(__atomic_load_n(&s.generation, __ATOMIC_SEQ_CST) == generation)
+            syscall(SYS_futex, &s.generation, FUTEX_WAIT, generation, nullptr, nullptr, 0);
+        __atomic_sub_fetch(&s.waiterCount, 1, __ATOMIC_SEQ_CST);
+    }
+}
@@ -0,0 +1,41 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_UNIX_BARRIER_H
+#define GRAPH_ALGO_UNIX_BARRIER_H
+
+#include "../srv/UNIX_shm.h"
+
+typedef struct BarrierState
+{
+    int count;
+    int arrivedCount;
+    //Bumped when all of count processes arrive, futex word
+    int generation;
+    int waiterCount;
+}BarrierState;
+
+//Barrier of count processes in a shm segment, spinning like UNIX_doorbell before sleeping on a futex
+class UNIX_barrier
+{
+public:
+    UNIX_barrier();
+
+    int create(key_t key, int count, int auth);
+    int fetch(key_t key);
+    int detach();
+    int control(int cmd);
+
+    void wait();
+
+    int spinCount;
+
+private:
+    UNIX_shm state_shm;
+    BarrierState *state;
+};
+
+#endif //GRAPH_ALGO_UNIX_BARRIER_H
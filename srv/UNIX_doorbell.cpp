@@ -0,0 +1,111 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "UNIX_doorbell.h"
+
+#include <thread>
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+//Not FUTEX_PRIVATE_FLAG, since the word is shared between processes
+static void futexWait(int *addr, int val)
+{
+    syscall(SYS_futex, addr, FUTEX_WAIT, val, nullptr, nullptr, 0);
+}
+
+static void futexWake(int *addr)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+static inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+UNIX_doorbell::UNIX_doorbell()
+{
+    this->slot_shm = UNIX_shm();
+    this->slots = nullptr;
+    for(int i = 0; i < DOORBELL_CHANNEL_COUNT; i++) this->lastSeq[i] = 0;
+    this->spinCount = std::thread::hardware_concurrency() > 1 ? DOORBELL_SPIN_COUNT : 0;
+}
+
+int UNIX_doorbell::create(key_t key, int auth)
+{
+    //shmget zeroes the segment, so every seq starts from 0
+    int ret = this->slot_shm.create(key, DOORBELL_CHANNEL_COUNT * sizeof(DoorbellSlot), auth);
+    if(ret != -1) this->attach();
+
+    return ret;
+}
+
+int UNIX_doorbell::fetch(key_t key)
+{
+    //Kept attached between connections
+    if(this->slots != nullptr) return 0;
+
+    int ret = this->slot_shm.fetch(key);
+    if(ret != -1) this->attach();
+
+    return ret;
+}
+
+void UNIX_doorbell::attach()
+{
+    this->slot_shm.attach(0666);
+    this->slots = (DoorbellSlot *)this->slot_shm.shmaddr;
+
+    //Rings before attaching are not received
+    for(int i = 0; i < DOORBELL_CHANNEL_COUNT; i++)
+        this->lastSeq[i] = __atomic_load_n(&this->slots[i].seq, __ATOMIC_ACQUIRE);
+}
+
+int UNIX_doorbell::detach()
+{
+    this->slots = nullptr;
+    return this->slot_shm.detach();
+}
+
+int UNIX_doorbell::control(int cmd)
+{
+    return this->slot_shm.control(cmd);
+}
+
+void UNIX_doorbell::send(int channel, int cmd, int arg)
+{
+    auto &slot = this->slots[channel];
+
+    slot.cmd = cmd;
+    slot.arg = arg;
+    //seq_cst with the waiter count, so that either the waiter sees the new seq or the sender sees the waiter
+    __atomic_add_fetch(&slot.seq, 1, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&slot.waiterCount, __ATOMIC_SEQ_CST) > 0) futexWake(&slot.seq);
+}
+
+int UNIX_doorbell::recv(int channel, int *arg)
+{
+    auto &slot = this->slots[channel];
+    int last = this->lastSeq[channel];
+
+    for(int i = 0; i < this->spinCount && __atomic_load_n(&slot.seq, __ATOMIC_ACQUIRE) == last; i++)
+        cpuRelax();
+
+    if(__atomic_load_n(&slot.seq, __ATOMIC_ACQUIRE) == last)
+    {
+        __atomic_add_fetch(&slot.waiterCount, 1, __ATOMIC_SEQ_CST);
+        while(__atomic_load_n(&slot.seq, __ATOMIC_SEQ_CST) == last)
+            futexWait(&slot.seq, last);
+        __atomic_sub_fetch(&slot.waiterCount, 1, __ATOMIC_SEQ_CST);
+    }
+
+    this->lastSeq[channel] = __atomic_load_n(&slot.seq, __ATOMIC_ACQUIRE);
+    if(arg != nullptr) *arg = slot.arg;
+
+    return slot.cmd;
+}
@@ -0,0 +1,66 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_UNIX_DOORBELL_H
+#define GRAPH_ALGO_UNIX_DOORBELL_H
+
+#include "../srv/UNIX_shm.h"
+
+#define DOORBELL_CLI_CHANNEL 0
+#define DOORBELL_SRV_CHANNEL 1
+#define DOORBELL_CHANNEL_COUNT 2
+
+//Polls before sleeping on the futex, about a few microseconds
+#define DOORBELL_SPIN_COUNT 20000
+
+//One direction of the doorbell, in shm
+typedef struct DoorbellSlot
+{
+    //Bumped by every ring, futex word
+    int seq;
+    int waiterCount;
+    int cmd;
+    int arg;
+    //Slots on their own cache lines
+    char pad[48];
+}DoorbellSlot;
+
+//Typed command channel between UtilClient & UtilServer in a shm segment
+//A ring is a write of the command and a bump of seq, and the futex is woken only if the other side is sleeping on it
+//recv spins on seq for spinCount polls first, so that a quick answer costs no syscall at all
+//At most one command is in flight in each channel (request & answer), otherwise only the last one is received
+//Rings before the other side attaches (create or fetch) are not received, so the other side must attach before the first ring
+//UtilServer creates the doorbell before it serves, and UtilClient fetches it before it rings
+class UNIX_doorbell
+{
+public:
+    UNIX_doorbell();
+
+    int create(key_t key, int auth);
+    int fetch(key_t key);
+    int detach();
+    int control(int cmd);
+
+    void send(int channel, int cmd, int arg = 0);
+    //Wait for the next command in channel after the last one received by this object, and return it
+    int recv(int channel, int *arg = nullptr);
+
+    //0 on a single core, where the other side cannot run while spinning
+    int spinCount;
+
+    //Test
+    const static int testDoorbellKey = 0x5b1e7d10;
+    //Test end
+
+private:
+    UNIX_shm slot_shm;
+    DoorbellSlot *slots;
+    int lastSeq[DOORBELL_CHANNEL_COUNT];
+
+    void attach();
+};
+
+#endif //GRAPH_ALGO_UNIX_DOORBELL_H
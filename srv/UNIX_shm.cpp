@@ -4,39 +4,134 @@
 
 #include "UNIX_shm.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static int envBackend()
+{
+    auto env = getenv("GRAPH_ALGO_SHM_BACKEND");
+    return env != nullptr && std::string("posix") == env ? SHM_BACKEND_POSIX : SHM_BACKEND_SYSV;
+}
+
+static bool envIsHugePage()
+{
+    auto env = getenv("GRAPH_ALGO_SHM_HUGEPAGE");
+    return env != nullptr && std::string("1") == env;
+}
+
+int UNIX_shm::defaultBackend = envBackend();
+bool UNIX_shm::defaultIsHugePage = envIsHugePage();
+
+void UNIX_shm::setBackend(int backend, bool isHugePage)
+{
+    UNIX_shm::defaultBackend = backend;
+    UNIX_shm::defaultIsHugePage = isHugePage;
+}
+
 UNIX_shm::UNIX_shm()
 {
     this->shmid = -1;
     this->shmaddr = nullptr;
     this->buf = new struct shmid_ds;
+
+    this->backend = UNIX_shm::defaultBackend;
+    this->isHugePage = UNIX_shm::defaultIsHugePage;
+    this->size = 0;
 }
 
 int UNIX_shm::create(key_t key, size_t size, int auth)
 {
-    this->shmid = shmget(key, size, (IPC_CREAT | IPC_EXCL | auth));
+    if(this->isHugePage) size = (size + SHM_HUGE_PAGE_SIZE - 1) / SHM_HUGE_PAGE_SIZE * SHM_HUGE_PAGE_SIZE;
+
+    if(this->backend == SHM_BACKEND_POSIX)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "/graph_algo_%08x", (unsigned)key);
+        this->name = name;
+        this->size = size;
+
+        this->shmid = shm_open(name, (O_CREAT | O_EXCL | O_RDWR), auth);
+        if(this->shmid != -1 && ftruncate(this->shmid, size) == -1)
+        {
+            close(this->shmid);
+            shm_unlink(name);
+            this->shmid = -1;
+        }
+    }
+    else
+    {
+        //Reserved huge pages may be not enough, and small pages are used then
+        this->shmid = -1;
+        if(this->isHugePage) this->shmid = shmget(key, size, (IPC_CREAT | IPC_EXCL | SHM_HUGETLB | auth));
+        if(this->shmid == -1) this->shmid = shmget(key, size, (IPC_CREAT | IPC_EXCL | auth));
+    }
 
     return this->shmid;
 }
 
 int UNIX_shm::fetch(key_t key)
 {
-    this->shmid = shmget(key, 0, 0);
+    if(this->backend == SHM_BACKEND_POSIX)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "/graph_algo_%08x", (unsigned)key);
+        this->name = name;
+
+        if(this->shmid != -1) close(this->shmid);
+        this->shmid = shm_open(name, O_RDWR, 0);
+
+        struct stat st;
+        if(this->shmid != -1 && fstat(this->shmid, &st) != -1) this->size = st.st_size;
+    }
+    else this->shmid = shmget(key, 0, 0);
 
     return this->shmid;
 }
 
 void UNIX_shm::attach(int auth)
 {
-    this->shmaddr = (char *)shmat(this->shmid, nullptr, 0);
+    if(this->backend == SHM_BACKEND_POSIX)
+    {
+        //Edge & value segments are all read by every superstep, so they are prefaulted
+        void *addr = mmap(nullptr, this->size, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_POPULATE), this->shmid, 0);
+
+        //The mapping does not need the fd, which would be leaked by clients connecting every superstep otherwise
+        close(this->shmid);
+        this->shmid = -1;
+
+        if(addr == MAP_FAILED) {this->shmaddr = nullptr; return; }
+
+        if(this->isHugePage) madvise(addr, this->size, MADV_HUGEPAGE);
+        this->shmaddr = (char *)addr;
+    }
+    else this->shmaddr = (char *)shmat(this->shmid, nullptr, 0);
 }
 
 int UNIX_shm::detach()
 {
-    return shmdt(this->shmaddr);
+    if(this->backend == SHM_BACKEND_POSIX)
+    {
+        if(this->shmaddr == nullptr) return -1;
+        int ret = munmap(this->shmaddr, this->size);
+        this->shmaddr = nullptr;
+        return ret;
+    }
+    else return shmdt(this->shmaddr);
 }
 
 int UNIX_shm::control(int cmd)
 {
-    return shmctl(this->shmid, cmd, this->buf);
+    if(this->backend == SHM_BACKEND_POSIX)
+    {
+        //Only removal, the mapping stays valid until it is detached
+        if(cmd != IPC_RMID || this->name.empty()) return -1;
+        if(this->shmid != -1) close(this->shmid);
+        this->shmid = -1;
+        return shm_unlink(this->name.c_str());
+    }
+    else return shmctl(this->shmid, cmd, this->buf);
 }
-
@@ -9,11 +9,23 @@
 
 #include "sys/shm.h"
 
+#include <string>
+
+#define SHM_BACKEND_SYSV 0
+#define SHM_BACKEND_POSIX 1
+
+//Alignment of huge page segments
+#define SHM_HUGE_PAGE_SIZE (2UL << 20)
+
 class UNIX_shm
 {
 public:
     UNIX_shm();
 
+    //Backend & huge pages of segments constructed after it, for every process sharing them
+    //Defaults come from environment variables GRAPH_ALGO_SHM_BACKEND ("sysv" or "posix") & GRAPH_ALGO_SHM_HUGEPAGE ("1")
+    static void setBackend(int backend, bool isHugePage);
+
     int create(key_t key, size_t size, int auth);
     int fetch(key_t key);
     void attach(int auth);
@@ -22,6 +34,11 @@ public:
 
     char *shmaddr;
 
+    //SysV: shmget/shmat, not above shmmax, and with SHM_HUGETLB if huge pages are reserved
+    //POSIX: shm_open/mmap on /dev/shm, prefaulted with MAP_POPULATE and with transparent huge page hints
+    int backend;
+    bool isHugePage;
+
     //Test
     const static int testSHMKey = 0xa3deaf72;
     //Test end
@@ -29,6 +46,13 @@ public:
 private:
     int shmid;
     struct shmid_ds *buf;
+
+    //POSIX backend
+    std::string name;
+    size_t size;
+
+    static int defaultBackend;
+    static bool defaultIsHugePage;
 };
 
 #endif //GRAPH_ALGO_UNIX_SHM_H
@@ -3,12 +3,63 @@
 //
 
 #include <cstring>
+#include <algorithm>
 #include "UtilClient.h"
 
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+//Vertices reduced at a time, so that the block of the result stays in cache while every node is read
+#define GATHER_BLOCK_SIZE 2048
+
+template <typename T>
+static inline void minInto(T *dst, const T *src, int count)
+{
+    for(int i = 0; i < count; i++)
+    {
+        if(src[i] < dst[i]) dst[i] = src[i];
+    }
+}
+
+static inline void minInto(double *dst, const double *src, int count)
+{
+    int i = 0;
+
+#if defined(__AVX__)
+    for(; i + 4 <= count; i += 4)
+        _mm256_storeu_pd(dst + i, _mm256_min_pd(_mm256_loadu_pd(src + i), _mm256_loadu_pd(dst + i)));
+#elif defined(__SSE2__)
+    for(; i + 2 <= count; i += 2)
+        _mm_storeu_pd(dst + i, _mm_min_pd(_mm_loadu_pd(src + i), _mm_loadu_pd(dst + i)));
+#endif
+
+    for(; i < count; i++)
+    {
+        if(src[i] < dst[i]) dst[i] = src[i];
+    }
+}
+
+static inline void orInto(char *dst, const char *src, size_t count)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for(; i + 32 <= count; i += 32)
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(src + i)), _mm256_loadu_si256((const __m256i *)(dst + i))));
+#elif defined(__SSE2__)
+    for(; i + 16 <= count; i += 16)
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_loadu_si128((const __m128i *)(src + i)), _mm_loadu_si128((const __m128i *)(dst + i))));
+#endif
+
+    for(; i < count; i++) dst[i] |= src[i];
+}
+
 template <typename VertexValueType, typename MessageValueType>
-UtilClient<VertexValueType, MessageValueType>::UtilClient(int vCount, int eCount, int numOfInitV, int nodeNo)
+UtilClient<VertexValueType, MessageValueType>::UtilClient(int vCount, int eCount, int numOfInitV, int nodeNo, int graphNo)
 {
     this->nodeNo = nodeNo;
+    this->graphNo = graphNo;
 
     this->numOfInitV = numOfInitV;
     this->vCount = vCount;
@@ -21,9 +72,10 @@ UtilClient<VertexValueType, MessageValueType>::UtilClient(int vCount, int eCount
     this->initVSet_shm = UNIX_shm();
     this->filteredV_shm = UNIX_shm();
     this->filteredVCount_shm = UNIX_shm();
+    this->changedV_shm = UNIX_shm();
+    this->modifiedV_shm = UNIX_shm();
 
-    this->server_msq = UNIX_msg();
-    this->client_msq = UNIX_msg();
+    this->doorbell = UNIX_doorbell();
 
     this->vValues = nullptr;
     this->mValues = nullptr;
@@ -32,6 +84,39 @@ UtilClient<VertexValueType, MessageValueType>::UtilClient(int vCount, int eCount
     this->initVSet = nullptr;
     this->filteredV = nullptr;
     this->filteredVCount = nullptr;
+    this->changedVCount = nullptr;
+    this->changedVSet = nullptr;
+    this->modifiedVCount = nullptr;
+    this->modifiedVSet = nullptr;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+key_t UtilClient<VertexValueType, MessageValueType>::keyOf(int shmID)
+{
+    return (this->nodeNo << NODE_NUM_OFFSET) | (shmID << SHM_OFFSET) | (this->graphNo << GRAPH_OFFSET);
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int UtilClient<VertexValueType, MessageValueType>::load()
+{
+    if(this->doorbell.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (DOORBELL_SHM << SHM_OFFSET))) == -1) return -1;
+
+    auto loadInfo_shm = UNIX_shm();
+    if(loadInfo_shm.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (LOADINFO_SHM << SHM_OFFSET))) == -1) return -1;
+    loadInfo_shm.attach(0666);
+
+    auto loadInfo = (LoadInfo *)loadInfo_shm.shmaddr;
+    loadInfo->vCount = this->vCount;
+    loadInfo->eCount = this->eCount;
+    loadInfo->numOfInitV = this->numOfInitV;
+
+    loadInfo_shm.detach();
+
+    int ret = 0;
+    this->doorbell.send(DOORBELL_CLI_CHANNEL, LOAD_CMD, this->graphNo);
+    this->doorbell.recv(DOORBELL_SRV_CHANNEL, &ret);
+
+    return ret;
 }
 
 template <typename VertexValueType, typename MessageValueType>
@@ -39,16 +124,17 @@ int UtilClient<VertexValueType, MessageValueType>::connect()
 {
     int ret = 0;
 
-    if(ret != -1) ret = this->vValues_shm.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (VVALUES_SHM << SHM_OFFSET)));
-    if(ret != -1) ret = this->mValues_shm.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (MVALUES_SHM << SHM_OFFSET)));
-    if(ret != -1) ret = this->vSet_shm.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (VSET_SHM << SHM_OFFSET)));
-    if(ret != -1) ret = this->eSet_shm.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (ESET_SHM << SHM_OFFSET)));
-    if(ret != -1) ret = this->initVSet_shm.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (INITVSET_SHM << SHM_OFFSET)));
-    if(ret != -1) ret = this->filteredV_shm.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (FILTEREDV_SHM << SHM_OFFSET)));
-    if(ret != -1) ret = this->filteredVCount_shm.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (FILTEREDVCOUNT_SHM << SHM_OFFSET)));
+    if(ret != -1) ret = this->vValues_shm.fetch(this->keyOf(VVALUES_SHM));
+    if(ret != -1) ret = this->mValues_shm.fetch(this->keyOf(MVALUES_SHM));
+    if(ret != -1) ret = this->vSet_shm.fetch(this->keyOf(VSET_SHM));
+    if(ret != -1) ret = this->eSet_shm.fetch(this->keyOf(ESET_SHM));
+    if(ret != -1) ret = this->initVSet_shm.fetch(this->keyOf(INITVSET_SHM));
+    if(ret != -1) ret = this->filteredV_shm.fetch(this->keyOf(FILTEREDV_SHM));
+    if(ret != -1) ret = this->filteredVCount_shm.fetch(this->keyOf(FILTEREDVCOUNT_SHM));
 
-    if(ret != -1) ret = this->server_msq.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (SRV_MSG_TYPE << MSG_TYPE_OFFSET)));
-    if(ret != -1) ret = this->client_msq.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (CLI_MSG_TYPE << MSG_TYPE_OFFSET)));
+    if(ret != -1) ret = this->changedV_shm.fetch(this->keyOf(CHANGEDV_SHM));
+    if(ret != -1) ret = this->modifiedV_shm.fetch(this->keyOf(MODIFIEDV_SHM));
+    if(ret != -1) ret = this->doorbell.fetch(((this->nodeNo << NODE_NUM_OFFSET) | (DOORBELL_SHM << SHM_OFFSET)));
 
     if(ret != -1)
     {
@@ -59,6 +145,8 @@ int UtilClient<VertexValueType, MessageValueType>::connect()
         this->initVSet_shm.attach(0666);
         this->filteredV_shm.attach(0666);
         this->filteredVCount_shm.attach(0666);
+        this->changedV_shm.attach(0666);
+        this->modifiedV_shm.attach(0666);
 
         this->vValues = (VertexValueType *)this->vValues_shm.shmaddr;
         this->mValues = (MessageValueType *)this->mValues_shm.shmaddr;
@@ -67,6 +155,10 @@ int UtilClient<VertexValueType, MessageValueType>::connect()
         this->initVSet = (int *)this->initVSet_shm.shmaddr;
         this->filteredV = (bool *)this->filteredV_shm.shmaddr;
         this->filteredVCount = (int *)this->filteredVCount_shm.shmaddr;
+        this->changedVCount = (int *)this->changedV_shm.shmaddr;
+        this->changedVSet = this->changedVCount + 1;
+        this->modifiedVCount = (int *)this->modifiedV_shm.shmaddr;
+        this->modifiedVSet = this->modifiedVCount + 1;
     }
 
     return ret;
@@ -83,6 +175,7 @@ int UtilClient<VertexValueType, MessageValueType>::transfer(VertexValueType *vVa
         if(this->initVSet == nullptr) return -1;
         if(this->filteredV == nullptr) return -1;
         if(this->filteredVCount == nullptr) return -1;
+        if(this->changedVCount == nullptr) return -1;
 
         memcpy(this->vValues, vValues, this->vCount * this->numOfInitV * sizeof(VertexValueType));
         memcpy(this->vSet, vSet, this->vCount * sizeof(Vertex));
@@ -90,6 +183,7 @@ int UtilClient<VertexValueType, MessageValueType>::transfer(VertexValueType *vVa
         memcpy(this->initVSet, initVSet, this->numOfInitV * sizeof(int));
         memcpy(this->filteredV, filteredV, this->vCount * sizeof(bool));
         memcpy(this->filteredVCount, &filteredVCount, sizeof(int));
+        *this->changedVCount = -1;
         return 0;
     }
     else return -1;
@@ -102,9 +196,41 @@ int UtilClient<VertexValueType, MessageValueType>::update(VertexValueType *vValu
     {
         if(this->vValues == nullptr) return -1;
         if(this->vSet == nullptr) return -1;
+        if(this->changedVCount == nullptr) return -1;
 
         memcpy(this->vValues, vValues, this->vCount * this->numOfInitV * sizeof(VertexValueType));
         memcpy(this->vSet, vSet, this->vCount * sizeof(Vertex));
+        *this->changedVCount = -1;
+        return 0;
+    }
+    else return -1;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int UtilClient<VertexValueType, MessageValueType>::update(VertexValueType *vValues, Vertex *vSet, const int *changedVSet, int changedVCount)
+{
+    if(this->vCount > 0 && this->eCount > 0 && this->numOfInitV > 0)
+    {
+        if(this->vValues == nullptr) return -1;
+        if(this->vSet == nullptr) return -1;
+        if(this->changedVCount == nullptr) return -1;
+
+        for(int i = 0; i < changedVCount; i++)
+        {
+            int vID = changedVSet[i];
+            memcpy(&this->vValues[vID * this->numOfInitV], &vValues[vID * this->numOfInitV], this->numOfInitV * sizeof(VertexValueType));
+            this->vSet[vID] = vSet[vID];
+        }
+
+        //Appended to changes not yet read by the server, and all of them are marked changed once the list is full
+        int &count = *this->changedVCount;
+        if(count >= 0 && count + changedVCount <= this->vCount)
+        {
+            memcpy(&this->changedVSet[count], changedVSet, changedVCount * sizeof(int));
+            count += changedVCount;
+        }
+        else count = -1;
+
         return 0;
     }
     else return -1;
@@ -113,10 +239,53 @@ int UtilClient<VertexValueType, MessageValueType>::update(VertexValueType *vValu
 template <typename VertexValueType, typename MessageValueType>
 void UtilClient<VertexValueType, MessageValueType>::request()
 {
-    char tmp[256];
+    this->sendRequest();
+    this->waitRequest();
+}
 
-    this->client_msq.send("execute", (CLI_MSG_TYPE << MSG_TYPE_OFFSET), 256);
-    this->server_msq.recv(tmp, (SRV_MSG_TYPE << MSG_TYPE_OFFSET), 256);
+template <typename VertexValueType, typename MessageValueType>
+void UtilClient<VertexValueType, MessageValueType>::sendRequest()
+{
+    this->doorbell.send(DOORBELL_CLI_CHANNEL, EXECUTE_CMD);
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void UtilClient<VertexValueType, MessageValueType>::waitRequest()
+{
+    this->doorbell.recv(DOORBELL_SRV_CHANNEL);
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int UtilClient<VertexValueType, MessageValueType>::requestN(int n)
+{
+    int iterCount = 0;
+
+    this->doorbell.send(DOORBELL_CLI_CHANNEL, RUN_CMD, n);
+    this->doorbell.recv(DOORBELL_SRV_CHANNEL, &iterCount);
+
+    return iterCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int UtilClient<VertexValueType, MessageValueType>::requestUntilConverged()
+{
+    return this->requestN(RUN_UNTIL_CONVERGED);
+}
+
+template <typename VertexValueType, typename MessageValueType>
+void UtilClient<VertexValueType, MessageValueType>::requestPeerRun(int n)
+{
+    this->doorbell.send(DOORBELL_CLI_CHANNEL, PEER_RUN_CMD, n);
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int UtilClient<VertexValueType, MessageValueType>::waitPeerRun()
+{
+    int iterCount = 0;
+
+    this->doorbell.recv(DOORBELL_SRV_CHANNEL, &iterCount);
+
+    return iterCount;
 }
 
 template <typename VertexValueType, typename MessageValueType>
@@ -129,6 +298,8 @@ void UtilClient<VertexValueType, MessageValueType>::disconnect()
     this->initVSet_shm.detach();
     this->filteredV_shm.detach();
     this->filteredVCount_shm.detach();
+    this->changedV_shm.detach();
+    this->modifiedV_shm.detach();
 
     this->vValues = nullptr;
     this->mValues = nullptr;
@@ -137,11 +308,100 @@ void UtilClient<VertexValueType, MessageValueType>::disconnect()
     this->initVSet = nullptr;
     this->filteredV = nullptr;
     this->filteredVCount = nullptr;
+    this->changedVCount = nullptr;
+    this->changedVSet = nullptr;
+    this->modifiedVCount = nullptr;
+    this->modifiedVSet = nullptr;
 }
 
 template <typename VertexValueType, typename MessageValueType>
 void UtilClient<VertexValueType, MessageValueType>::shutdown()
 {
-    this->client_msq.send("exit", (CLI_MSG_TYPE << MSG_TYPE_OFFSET), 256);
+    this->doorbell.send(DOORBELL_CLI_CHANNEL, EXIT_CMD);
     this->disconnect();
+    this->doorbell.detach();
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int UtilClient<VertexValueType, MessageValueType>::gather(std::vector<UtilClient<VertexValueType, MessageValueType>> &clients, VertexValueType *vValues, Vertex *vSet, WorkerPool *pool)
+{
+    if(clients.empty()) return 0;
+
+    int vCount = clients.at(0).vCount;
+    int numOfInitV = clients.at(0).numOfInitV;
+    int workerCount = pool == nullptr ? 1 : pool->threadCount;
+    auto avCountSet = std::vector<int>(workerCount, 0);
+
+    auto gatherRange = [&](int t)
+    {
+        int begin = (int)((long long)vCount * t / workerCount), end = (int)((long long)vCount * (t + 1) / workerCount);
+
+        for(int blockBegin = begin; blockBegin < end; blockBegin += GATHER_BLOCK_SIZE)
+        {
+            int blockEnd = std::min(blockBegin + GATHER_BLOCK_SIZE, end);
+            int count = blockEnd - blockBegin;
+
+            //Vertices differ in isActive only, whose OR is the OR of whole vertices bytewise then
+            memcpy(&vSet[blockBegin], &clients.at(0).vSet[blockBegin], count * sizeof(Vertex));
+            for(auto &uc : clients)
+            {
+                minInto(&vValues[blockBegin * numOfInitV], &uc.vValues[blockBegin * numOfInitV], count * numOfInitV);
+                if(&uc != &clients.at(0))
+                    orInto((char *)&vSet[blockBegin], (const char *)&uc.vSet[blockBegin], count * sizeof(Vertex));
+            }
+
+            for(int i = blockBegin; i < blockEnd; i++) avCountSet.at(t) += vSet[i].isActive;
+        }
+    };
+
+    if(pool == nullptr) gatherRange(0);
+    else pool->run(gatherRange);
+
+    int avCount = 0;
+    for(int c : avCountSet) avCount += c;
+
+    return avCount;
+}
+
+template <typename VertexValueType, typename MessageValueType>
+int UtilClient<VertexValueType, MessageValueType>::query(std::vector<UtilClient<VertexValueType, MessageValueType>> &clients, const int *sources, int count, VertexValueType *results)
+{
+    if(clients.empty()) return 0;
+
+    auto &head = clients.at(0);
+    int vCount = head.vCount;
+    int numOfInitV = head.numOfInitV;
+    int runCount = 0;
+
+    for(int begin = 0; begin < count; begin += numOfInitV)
+    {
+        int laneCount = std::min(numOfInitV, count - begin);
+
+        //Lanes left in the last run have no source
+        for(auto &uc : clients)
+        {
+            for(int j = 0; j < numOfInitV; j++) uc.initVSet[j] = j < laneCount ? sources[begin + j] : -1;
+            uc.doorbell.send(DOORBELL_CLI_CHANNEL, QUERY_CMD, (int)clients.size());
+        }
+
+        bool isSupported = true;
+        for(auto &uc : clients)
+        {
+            int ret = 0;
+            uc.doorbell.recv(DOORBELL_SRV_CHANNEL, &ret);
+            isSupported &= ret != -1;
+        }
+        if(!isSupported) return -1;
+
+        //Every server has the whole result
+        for(int v = 0; v < vCount; v++)
+        {
+            for(int j = 0; j < laneCount; j++)
+                results[(long long)(begin + j) * vCount + v] = head.vValues[v * numOfInitV + j];
+        }
+
+        runCount++;
+    }
+
+    return runCount;
 }
@@ -9,24 +9,53 @@
 
 #include "../core/GraphUtil.h"
 #include "../srv/UNIX_shm.h"
-#include "../srv/UNIX_msg.h"
+#include "../srv/UNIX_doorbell.h"
+#include "../srv/WorkerPool.h"
 #include "../include/UNIX_marco.h"
 
 template <typename VertexValueType, typename MessageValueType>
 class UtilClient
 {
 public:
-    UtilClient(int vCount, int eCount, int numOfInitV, int nodeNo = 0);
+    UtilClient(int vCount, int eCount, int numOfInitV, int nodeNo = 0, int graphNo = 0);
     ~UtilClient() = default;
 
+    //Makes the server serve the graph of this client in slot graphNo, whose segments are kept with the others loaded before
+    //They are re-created only if the slot had a smaller graph, and the server should be loaded before connect
+    //Vertices & edges stay in the slot, while states of the executor do not
+    int load();
     int connect();
     int transfer(VertexValueType *vValues, Vertex *vSet, Edge *eSet, int *initVSet, bool *filteredV, int filteredVCount);
     int update(VertexValueType *vValues, Vertex *vSet);
+    //Only vertices in changedVSet are written, and they are added to the changed list read by the server in the next request
+    int update(VertexValueType *vValues, Vertex *vSet, const int *changedVSet, int changedVCount);
     void request();
+    //request() in two halves, so that the server computes while the client writes to other servers
+    void sendRequest();
+    void waitRequest();
+    //Supersteps are run by the server until no vertex is active (or n of them are run), without any round trip between them
+    //Only for a single node or servers sharing their state, and the count of supersteps run is returned
+    int requestN(int n);
+    int requestUntilConverged();
+    //Like requestN, but servers exchange boundary values with each other (see UtilServer::nodeCount)
+    //It is sent to every node before waiting for any of them, and the count is -1 if servers do not support it
+    void requestPeerRun(int n);
+    int waitPeerRun();
     void disconnect();
     void shutdown();
 
+    //vValues become the min of themselves & vValues of every client, and isActive of vSet becomes the OR of every client's
+    //Clients should be connected, with vertices the same on every node but isActive (as they are after transfer)
+    //Vertex ranges are reduced in parallel on pool (or on the calling thread if it is nullptr), and the count of active vertices is returned
+    static int gather(std::vector<UtilClient<VertexValueType, MessageValueType>> &clients, VertexValueType *vValues, Vertex *vSet, WorkerPool *pool = nullptr);
+
+    //Runs a query from every source of sources[0 .. count) on servers of the partitions of the graph, numOfInitV queries at a time as lanes of one run
+    //Clients should be connected, and edges transferred before are kept by servers between queries, so that only initVSet is written for a run
+    //results[q * vCount + v] is the value of v in query q, and the count of runs (or -1 if servers do not support queries, or are not started with nodeCount of clients) is returned
+    static int query(std::vector<UtilClient<VertexValueType, MessageValueType>> &clients, const int *sources, int count, VertexValueType *results);
+
     int nodeNo;
+    int graphNo;
 
     int vCount;
     int eCount;
@@ -40,6 +69,15 @@ public:
     Vertex *vSet;
     Edge *eSet;
 
+    //Count at [0] followed by vertex IDs
+    //Vertices written by the client since the last request, or -1 as the count if all of them may be changed
+    int *changedVCount;
+    int *changedVSet;
+    //Vertices whose values were changed by the server, or which are active, in the last request
+    //isActive of every other vertex is false after it
+    int *modifiedVCount;
+    int *modifiedVSet;
+
 private:
     UNIX_shm initVSet_shm;
     UNIX_shm filteredV_shm;
@@ -48,9 +86,13 @@ private:
     UNIX_shm mValues_shm;
     UNIX_shm vSet_shm;
     UNIX_shm eSet_shm;
+    UNIX_shm changedV_shm;
+    UNIX_shm modifiedV_shm;
+
+    //Stays attached after disconnect until shutdown
+    UNIX_doorbell doorbell;
 
-    UNIX_msg server_msq;
-    UNIX_msg client_msq;
+    key_t keyOf(int shmID);
 };
 
 #endif //GRAPH_ALGO_UTILCLIENT_H
@@ -5,7 +5,71 @@
 #include "../srv/UtilServer.h"
 #include "../util/TIsExtended.hpp"
 #include <string>
+#include <cstring>
+#include <algorithm>
 #include <iostream>
+#include <unistd.h>
+
+//Layout of segments between servers: a header of counts, then vertex IDs, flags & values of capacity vertices
+//Parts are aligned to cache lines, so that values are aligned as well
+#define PEER_HEADER_SIZE 64
+
+static size_t peerAlign(size_t size)
+{
+    return (size + 63) / 64 * 64;
+}
+
+template <typename T>
+static size_t peerBufferSize(int capacity, int laneCount)
+{
+    return PEER_HEADER_SIZE + peerAlign(capacity * sizeof(int)) + peerAlign(capacity * sizeof(char)) + capacity * laneCount * sizeof(T);
+}
+
+template <typename T>
+static void peerBufferOf(char *addr, int capacity, int **header, int **vIDs, char **flags, T **values)
+{
+    *header = (int *)addr;
+    *vIDs = (int *)(addr + PEER_HEADER_SIZE);
+    *flags = (char *)*vIDs + peerAlign(capacity * sizeof(int));
+    *values = (T *)(*flags + peerAlign(capacity * sizeof(char)));
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+UtilServerGraph<GraphUtilType, VertexValueType, MessageValueType>::UtilServerGraph()
+{
+    this->graphNo = 0;
+    this->executor = GraphUtilType();
+
+    //No graph yet
+    this->vCount = 0;
+    this->eCount = 0;
+    this->numOfInitV = 0;
+
+    this->vValues = nullptr;
+    this->mValues = nullptr;
+    this->vSet = nullptr;
+    this->eSet = nullptr;
+    this->initVSet = nullptr;
+    this->filteredV = nullptr;
+    this->filteredVCount = nullptr;
+    this->changedVCount = nullptr;
+    this->changedVSet = nullptr;
+    this->modifiedVCount = nullptr;
+    this->modifiedVSet = nullptr;
+
+    this->vValues_shm = UNIX_shm();
+    this->mValues_shm = UNIX_shm();
+    this->vSet_shm = UNIX_shm();
+    this->eSet_shm = UNIX_shm();
+    this->initVSet_shm = UNIX_shm();
+    this->filteredV_shm = UNIX_shm();
+    this->filteredVCount_shm = UNIX_shm();
+    this->changedV_shm = UNIX_shm();
+    this->modifiedV_shm = UNIX_shm();
+    this->segmentCapacity.assign(MODIFIEDV_SHM + 1, 0);
+
+    this->isPeerConnected = false;
+}
 
 template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
 UtilServer<GraphUtilType, VertexValueType, MessageValueType>::UtilServer(int vCount, int eCount, int numOfInitV, int nodeNo)
@@ -15,10 +79,9 @@ UtilServer<GraphUtilType, VertexValueType, MessageValueType>::UtilServer(int vCo
     //Test end
 
     this->nodeNo = nodeNo;
-
-    this->vCount = vCount;
-    this->eCount = eCount;
-    this->numOfInitV = numOfInitV;
+    this->threadCount = 1;
+    this->nodeCount = 1;
+    this->loadInfo = nullptr;
 
     this->isLegal = TIsExtended<GraphUtilType, GraphUtil<VertexValueType, MessageValueType>>::Result &&
                     vCount > 0 &&
@@ -26,95 +89,38 @@ UtilServer<GraphUtilType, VertexValueType, MessageValueType>::UtilServer(int vCo
                     numOfInitV > 0 &&
                     nodeNo >= 0;
 
-    this->vValues = nullptr;
-    this->mValues = nullptr;
-    this->vSet = nullptr;
-    this->eSet = nullptr;
-    this->initVSet = nullptr;
-    this->filteredV = nullptr;
-    this->filteredVCount = nullptr;
-
     if(this->isLegal)
     {
         int chk = 0;
 
-        this->executor = GraphUtilType();
-        this->executor.Init(vCount, eCount, numOfInitV);
-        this->vValues_shm = UNIX_shm();
-        this->vSet_shm = UNIX_shm();
-        this->eSet_shm = UNIX_shm();
-        this->initVSet_shm = UNIX_shm();
-        this->filteredV_shm = UNIX_shm();
-        this->filteredVCount_shm = UNIX_shm();
-
-        this->server_msq = UNIX_msg();
+        this->doorbell = UNIX_doorbell();
+        this->loadInfo_shm = UNIX_shm();
         this->init_msq = UNIX_msg();
-        this->client_msq = UNIX_msg();
 
         if(chk != -1)
-            chk = this->vValues_shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (VVALUES_SHM << SHM_OFFSET)),
-                this->executor.totalVValuesCount * sizeof(VertexValueType),
-                0666);
-        if(chk != -1)
-            chk = this->mValues_shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (MVALUES_SHM << SHM_OFFSET)),
-                this->executor.totalMValuesCount * sizeof(MessageValueType),
-                0666);
-        if(chk != -1)
-            chk = this->vSet_shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (VSET_SHM << SHM_OFFSET)),
-                this->vCount * sizeof(Vertex),
-                0666);
-        if(chk != -1)
-            chk = this->eSet_shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (ESET_SHM << SHM_OFFSET)),
-                this->eCount * sizeof(Edge),
-                0666);
-        if(chk != -1)
-            chk = this->initVSet_shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (INITVSET_SHM << SHM_OFFSET)),
-                this->numOfInitV * sizeof(int),
-                0666);
-        if(chk != -1)
-            chk = this->filteredV_shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (FILTEREDV_SHM << SHM_OFFSET)),
-                this->vCount * sizeof(bool),
-                0666);
-        if(chk != -1)
-            chk = this->filteredVCount_shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (FILTEREDVCOUNT_SHM << SHM_OFFSET)),
-                sizeof(int),
-                0666);
+            chk = this->load(0, vCount, eCount, numOfInitV);
 
         if(chk != -1)
-            chk = this->server_msq.create(((this->nodeNo << NODE_NUM_OFFSET) | (SRV_MSG_TYPE << MSG_TYPE_OFFSET)),
+            chk = this->doorbell.create(((this->nodeNo << NODE_NUM_OFFSET) | (DOORBELL_SHM << SHM_OFFSET)),
                 0666);
         if(chk != -1)
-            chk = this->init_msq.create(((this->nodeNo << NODE_NUM_OFFSET) | (INIT_MSG_TYPE << MSG_TYPE_OFFSET)),
+            chk = this->loadInfo_shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (LOADINFO_SHM << SHM_OFFSET)),
+                sizeof(LoadInfo),
                 0666);
         if(chk != -1)
-            chk = this->client_msq.create(((this->nodeNo << NODE_NUM_OFFSET) | (CLI_MSG_TYPE << MSG_TYPE_OFFSET)),
+            chk = this->init_msq.create(((this->nodeNo << NODE_NUM_OFFSET) | (INIT_MSG_TYPE << MSG_TYPE_OFFSET)),
                 0666);
 
         if(chk != -1)
         {
-            this->vValues_shm.attach(0666);
-            this->mValues_shm.attach(0666);
-            this->vSet_shm.attach(0666);
-            this->eSet_shm.attach(0666);
-            this->initVSet_shm.attach(0666);
-            this->filteredV_shm.attach(0666);
-            this->filteredVCount_shm.attach(0666);
-
-            this->vValues = (VertexValueType *) this->vValues_shm.shmaddr;
-            this->mValues = (MessageValueType *) this->mValues_shm.shmaddr;
-            this->vSet = (Vertex *) this->vSet_shm.shmaddr;
-            this->eSet = (Edge *) this->eSet_shm.shmaddr;
-            this->initVSet = (int *) this->initVSet_shm.shmaddr;
-            this->filteredV = (bool *) this->filteredV_shm.shmaddr;
-            this->filteredVCount = (int *) this->filteredVCount_shm.shmaddr;
+            this->loadInfo_shm.attach(0666);
+            this->loadInfo = (LoadInfo *)this->loadInfo_shm.shmaddr;
 
             this->init_msq.send("initiated", (INIT_MSG_TYPE << MSG_TYPE_OFFSET), 256);
 
             //Test
             std::cout << "Init succeeded." << std::endl;
             //Test end
-
-            this->executor.Deploy(vCount, eCount, numOfInitV);
         }
         else
         {
@@ -130,7 +136,153 @@ UtilServer<GraphUtilType, VertexValueType, MessageValueType>::UtilServer(int vCo
 template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
 UtilServer<GraphUtilType, VertexValueType, MessageValueType>::~UtilServer()
 {
-    this->executor.Free();
+    this->pool = nullptr;
+    for(auto &workerExecutor : this->workerExecutors) workerExecutor.Free();
+
+    this->unload();
+    for(auto &parkedGraph : this->parkedGraphs)
+    {
+        static_cast<Graph_t &>(*this) = std::move(parkedGraph.second);
+        this->unload();
+    }
+    this->parkedGraphs.clear();
+
+    this->loadInfo = nullptr;
+    this->loadInfo_shm.detach();
+    this->loadInfo_shm.control(IPC_RMID);
+
+    this->doorbell.detach();
+    this->doorbell.control(IPC_RMID);
+    this->init_msq.control(IPC_RMID);
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+key_t UtilServer<GraphUtilType, VertexValueType, MessageValueType>::keyOf(int shmID)
+{
+    return (this->nodeNo << NODE_NUM_OFFSET) | (shmID << SHM_OFFSET) | (this->graphNo << GRAPH_OFFSET);
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+int UtilServer<GraphUtilType, VertexValueType, MessageValueType>::reserveSegments()
+{
+    int chk = 0;
+
+    if(chk != -1)
+        chk = this->reserveSegment(this->vValues_shm, VVALUES_SHM, this->executor.totalVValuesCount * sizeof(VertexValueType));
+    if(chk != -1)
+        chk = this->reserveSegment(this->mValues_shm, MVALUES_SHM, this->executor.totalMValuesCount * sizeof(MessageValueType));
+    if(chk != -1)
+        chk = this->reserveSegment(this->vSet_shm, VSET_SHM, this->vCount * sizeof(Vertex));
+    if(chk != -1)
+        chk = this->reserveSegment(this->eSet_shm, ESET_SHM, this->eCount * sizeof(Edge));
+    if(chk != -1)
+        chk = this->reserveSegment(this->initVSet_shm, INITVSET_SHM, this->numOfInitV * sizeof(int));
+    if(chk != -1)
+        chk = this->reserveSegment(this->filteredV_shm, FILTEREDV_SHM, this->vCount * sizeof(bool));
+    if(chk != -1)
+        chk = this->reserveSegment(this->filteredVCount_shm, FILTEREDVCOUNT_SHM, sizeof(int));
+    if(chk != -1)
+        chk = this->reserveSegment(this->changedV_shm, CHANGEDV_SHM, (this->vCount + 1) * sizeof(int));
+    if(chk != -1)
+        chk = this->reserveSegment(this->modifiedV_shm, MODIFIEDV_SHM, (this->vCount + 1) * sizeof(int));
+
+    if(chk == -1) return -1;
+
+    this->vValues = (VertexValueType *) this->vValues_shm.shmaddr;
+    this->mValues = (MessageValueType *) this->mValues_shm.shmaddr;
+    this->vSet = (Vertex *) this->vSet_shm.shmaddr;
+    this->eSet = (Edge *) this->eSet_shm.shmaddr;
+    this->initVSet = (int *) this->initVSet_shm.shmaddr;
+    this->filteredV = (bool *) this->filteredV_shm.shmaddr;
+    this->filteredVCount = (int *) this->filteredVCount_shm.shmaddr;
+    this->changedVCount = (int *) this->changedV_shm.shmaddr;
+    this->changedVSet = this->changedVCount + 1;
+    this->modifiedVCount = (int *) this->modifiedV_shm.shmaddr;
+    this->modifiedVSet = this->modifiedVCount + 1;
+
+    return 0;
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+int UtilServer<GraphUtilType, VertexValueType, MessageValueType>::reserveSegment(UNIX_shm &shm, int shmID, size_t size)
+{
+    auto &capacity = this->segmentCapacity.at(shmID);
+    if(shm.shmaddr != nullptr && capacity >= size) return 0;
+
+    //Clients attached keep the old segment until they reconnect
+    if(shm.shmaddr != nullptr)
+    {
+        shm.detach();
+        shm.control(IPC_RMID);
+    }
+    shm = UNIX_shm();
+    size_t lastCapacity = capacity;
+    capacity = 0;
+
+    //Grown by half at least, so that a slot of graphs growing bit by bit is not re-created every time
+    if(lastCapacity > 0) size = std::max(size, lastCapacity * 3 / 2);
+    if(shm.create(this->keyOf(shmID), size, 0666) == -1) return -1;
+    shm.attach(0666);
+    capacity = size;
+
+    return 0;
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+int UtilServer<GraphUtilType, VertexValueType, MessageValueType>::load(int graphNo, int vCount, int eCount, int numOfInitV)
+{
+    if(graphNo < 0 || graphNo >= MAX_GRAPH_COUNT || vCount <= 0 || eCount <= 0 || numOfInitV <= 0) return -1;
+
+    //The graph served is parked, and the one of graphNo takes its place
+    if(graphNo != this->graphNo)
+    {
+        this->parkedGraphs[this->graphNo] = std::move(static_cast<Graph_t &>(*this));
+
+        auto it = this->parkedGraphs.find(graphNo);
+        if(it != this->parkedGraphs.end())
+        {
+            static_cast<Graph_t &>(*this) = std::move(it->second);
+            this->parkedGraphs.erase(it);
+        }
+        else
+        {
+            static_cast<Graph_t &>(*this) = Graph_t();
+            this->graphNo = graphNo;
+        }
+    }
+
+    //Segments are kept if they are large enough, and the executor starts over since the graph may be another one of the same size
+    if(this->vCount > 0) this->executor.Free();
+    this->peerDisconnect();
+
+    this->vCount = vCount;
+    this->eCount = eCount;
+    this->numOfInitV = numOfInitV;
+
+    this->executor = GraphUtilType();
+    this->executor.Init(vCount, eCount, numOfInitV);
+    if(this->reserveSegments() == -1)
+    {
+        //Loaded again before it is served
+        this->vCount = 0;
+        return -1;
+    }
+    this->executor.Deploy(vCount, eCount, numOfInitV);
+
+    //Nothing is known by the client yet
+    *this->changedVCount = -1;
+    this->lastVValues.clear();
+
+    this->setupWorkers();
+
+    return 0;
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+void UtilServer<GraphUtilType, VertexValueType, MessageValueType>::unload()
+{
+    if(this->vCount > 0) this->executor.Free();
+    this->peerDisconnect();
 
     this->vValues = nullptr;
     this->mValues = nullptr;
@@ -139,18 +291,38 @@ UtilServer<GraphUtilType, VertexValueType, MessageValueType>::~UtilServer()
     this->initVSet = nullptr;
     this->filteredV = nullptr;
     this->filteredVCount = nullptr;
+    this->changedVCount = nullptr;
+    this->changedVSet = nullptr;
+    this->modifiedVCount = nullptr;
+    this->modifiedVSet = nullptr;
 
-    this->vValues_shm.control(IPC_RMID);
-    this->mValues_shm.control(IPC_RMID);
-    this->vSet_shm.control(IPC_RMID);
-    this->eSet_shm.control(IPC_RMID);
-    this->initVSet_shm.control(IPC_RMID);
-    this->filteredV_shm.control(IPC_RMID);
-    this->filteredVCount_shm.control(IPC_RMID);
+    for(auto shm : {&this->vValues_shm, &this->mValues_shm, &this->vSet_shm, &this->eSet_shm, &this->initVSet_shm,
+                    &this->filteredV_shm, &this->filteredVCount_shm, &this->changedV_shm, &this->modifiedV_shm})
+    {
+        if(shm->shmaddr == nullptr) continue;
+        shm->detach();
+        shm->control(IPC_RMID);
+    }
 
-    this->server_msq.control(IPC_RMID);
-    this->init_msq.control(IPC_RMID);
-    this->client_msq.control(IPC_RMID);
+    this->vCount = 0;
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+void UtilServer<GraphUtilType, VertexValueType, MessageValueType>::setupWorkers()
+{
+    for(auto &workerExecutor : this->workerExecutors) workerExecutor.Free();
+    this->workerExecutors.clear();
+    this->workerMValues.clear();
+
+    //Workers copy the executor as it is configured now
+    if(this->threadCount > 1 && this->executor.isMSGMergeable())
+    {
+        if(this->pool == nullptr || this->pool->threadCount != this->threadCount)
+            this->pool = std::make_shared<WorkerPool>(this->threadCount);
+        this->workerExecutors.assign(this->threadCount - 1, this->executor);
+        this->workerMValues.assign(this->threadCount - 1, std::vector<MessageValueType>(this->executor.totalMValuesCount));
+    }
+    else this->pool = nullptr;
 }
 
 template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
@@ -159,27 +331,122 @@ void UtilServer<GraphUtilType, VertexValueType, MessageValueType>::run()
     if(!this->isLegal) return;
 
     //VertexValueType *mValues = new VertexValueType [this->vCount * this->numOfInitV];
-    char msgp[256];
-    std::string cmd = std::string("");
-
     int iterCount = 0;
 
-    while(this->client_msq.recv(msgp, (CLI_MSG_TYPE << MSG_TYPE_OFFSET), 256) != -1)
+    this->setupWorkers();
+
+    while(true)
     {
+        int arg = 0;
+        int cmd = this->doorbell.recv(DOORBELL_CLI_CHANNEL, &arg);
+
         //Test
         std::cout << "Processing at iter " << ++iterCount << std::endl;
         //Test end
 
-        cmd = msgp;
-        if(std::string("execute") == cmd)
+        //A graph failed to load is not served
+        if((cmd == EXECUTE_CMD || cmd == RUN_CMD || cmd == PEER_RUN_CMD || cmd == QUERY_CMD) && this->vCount == 0)
+        {
+            this->doorbell.send(DOORBELL_SRV_CHANNEL, FINISHED_CMD, -1);
+            continue;
+        }
+
+        if(cmd == LOAD_CMD)
         {
-            int msgCount = this->executor.MSGGenMerge_array(this->vCount, this->eCount, this->vSet, this->eSet, this->numOfInitV, this->initVSet, this->vValues, this->mValues);
+            int ret = this->load(arg, this->loadInfo->vCount, this->loadInfo->eCount, this->loadInfo->numOfInitV);
+
+            this->doorbell.send(DOORBELL_SRV_CHANNEL, FINISHED_CMD, ret);
+        }
+        else if(cmd == EXECUTE_CMD)
+        {
+            this->syncChangedV();
+
+            int avCount = this->step();
 
-            int avCount = this->executor.MSGApply_array(this->vCount, msgCount, this->vSet, this->numOfInitV, this->initVSet, this->vValues, mValues);
+            this->publishModifiedV();
 
-            this->server_msq.send("finished", (SRV_MSG_TYPE << MSG_TYPE_OFFSET), 256);
+            this->doorbell.send(DOORBELL_SRV_CHANNEL, FINISHED_CMD);
         }
-        else if(std::string("exit") == cmd)
+        else if(cmd == RUN_CMD)
+        {
+            this->syncChangedV();
+
+            //Activity is checked in place, and the state is published once at the end
+            bool isActive = false;
+            for(int i = 0; i < this->vCount && !isActive; i++) isActive = this->vSet[i].isActive;
+
+            int runCount = 0;
+            while(isActive && (arg == RUN_UNTIL_CONVERGED || runCount < arg))
+            {
+                isActive = this->step() > 0;
+                runCount++;
+            }
+
+            this->publishModifiedV();
+
+            this->doorbell.send(DOORBELL_SRV_CHANNEL, FINISHED_CMD, runCount);
+        }
+        else if(cmd == PEER_RUN_CMD)
+        {
+            this->syncChangedV();
+
+            //The same for every node, so that either all of them or none of them run
+            if(!this->isPeerSupported())
+            {
+                this->doorbell.send(DOORBELL_SRV_CHANNEL, FINISHED_CMD, -1);
+                continue;
+            }
+
+            if(!this->isPeerConnected) this->peerConnect();
+
+            //Vertices are the same on every node after transfer, so the check needs no exchange
+            bool isActive = false;
+            for(int i = 0; i < this->vCount && !isActive; i++) isActive = this->vSet[i].isActive;
+
+            int runCount = 0;
+            while(isActive && (arg == RUN_UNTIL_CONVERGED || runCount < arg))
+            {
+                isActive = this->peerStep() > 0;
+                runCount++;
+            }
+
+            this->publishModifiedV();
+
+            this->doorbell.send(DOORBELL_SRV_CHANNEL, FINISHED_CMD, runCount);
+        }
+        else if(cmd == QUERY_CMD)
+        {
+            //Servers of the same graph run together, and all of them get the same reply
+            //arg is the count of nodes the client has, and a server which would run on its partition alone refuses it
+            bool isPeerRun = this->nodeCount > 1;
+            if(!this->executor.isQueryable() || arg != this->nodeCount || (isPeerRun && !this->isPeerSupported()))
+            {
+                this->doorbell.send(DOORBELL_SRV_CHANNEL, FINISHED_CMD, -1);
+                continue;
+            }
+
+            //A new run, so that values propagated in the last query are dropped by syncChangedV
+            this->executor.GraphInit_array(this->vCount, this->vSet, this->numOfInitV, this->initVSet, this->vValues);
+            *this->changedVCount = -1;
+            this->syncChangedV();
+
+            if(isPeerRun && !this->isPeerConnected) this->peerConnect();
+
+            bool isActive = false;
+            for(int i = 0; i < this->vCount && !isActive; i++) isActive = this->vSet[i].isActive;
+
+            int runCount = 0;
+            while(isActive)
+            {
+                isActive = (isPeerRun ? this->peerStep() : this->step()) > 0;
+                runCount++;
+            }
+
+            this->publishModifiedV();
+
+            this->doorbell.send(DOORBELL_SRV_CHANNEL, FINISHED_CMD, runCount);
+        }
+        else if(cmd == EXIT_CMD)
             break;
         else break;
     }
@@ -189,3 +456,310 @@ void UtilServer<GraphUtilType, VertexValueType, MessageValueType>::run()
     //Test end
 }
 
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+void UtilServer<GraphUtilType, VertexValueType, MessageValueType>::syncChangedV()
+{
+    //Values of a vertex, which are not one per initV for every algorithm
+    int laneCount = this->executor.totalVValuesCount / this->vCount;
+
+    if(*this->changedVCount < 0 || this->lastVValues.size() != this->vCount * laneCount)
+    {
+        //The whole state written by the client is a new run, whatever was propagated in the last one
+        if(*this->changedVCount < 0)
+        {
+            int workerCount = this->pool == nullptr ? 1 : this->pool->threadCount;
+            for(int t = 0; t < workerCount; t++) this->executorOf(t).ResetRunState();
+        }
+
+        this->lastVValues.assign(this->vValues, this->vValues + this->vCount * laneCount);
+    }
+    else
+    {
+        for(int i = 0; i < *this->changedVCount; i++)
+        {
+            int vID = this->changedVSet[i];
+            std::copy(&this->vValues[vID * laneCount], &this->vValues[(vID + 1) * laneCount], &this->lastVValues[vID * laneCount]);
+        }
+    }
+
+    *this->changedVCount = 0;
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+int UtilServer<GraphUtilType, VertexValueType, MessageValueType>::step()
+{
+    int msgCount = this->genMerge();
+
+    return this->apply(0, this->vCount, msgCount);
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+int UtilServer<GraphUtilType, VertexValueType, MessageValueType>::genMerge()
+{
+    if(this->pool == nullptr)
+        return this->executor.MSGGenMerge_array(this->vCount, this->eCount, this->vSet, this->eSet, this->numOfInitV, this->initVSet, this->vValues, this->mValues);
+
+    int workerCount = this->pool->threadCount;
+    int mLaneCount = this->executor.totalMValuesCount / this->vCount;
+
+    auto msgCountSet = std::vector<int>(workerCount, 0);
+
+    //Messages of every edge range
+    this->pool->run([&](int t)
+    {
+        auto eRange = this->rangeOf(this->eCount, t, workerCount);
+        msgCountSet.at(t) = this->executorOf(t).MSGGenMerge_array(this->vCount, eRange.second - eRange.first, this->vSet, this->eSet + eRange.first, this->numOfInitV, this->initVSet, this->vValues, this->mValuesOf(t));
+    });
+
+    //Merged into mValues by vertex ranges
+    this->pool->run([&](int t)
+    {
+        auto vRange = this->rangeOf(this->vCount, t, workerCount);
+        for(int k = 1; k < workerCount; k++)
+            this->executorOf(t).MSGMerge_array(vRange.second - vRange.first, this->numOfInitV, this->mValues + vRange.first * mLaneCount, this->mValuesOf(k) + vRange.first * mLaneCount);
+    });
+
+    return *std::max_element(msgCountSet.begin(), msgCountSet.end());
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+int UtilServer<GraphUtilType, VertexValueType, MessageValueType>::apply(int begin, int end, int msgCount)
+{
+    int vLaneCount = this->executor.totalVValuesCount / this->vCount;
+    int mLaneCount = this->executor.totalMValuesCount / this->vCount;
+
+    if(begin == 0 && end == this->vCount && (this->pool == nullptr || !this->executor.isApplyVertexLocal()))
+        return this->executor.MSGApply_array(this->vCount, msgCount, this->vSet, this->numOfInitV, this->initVSet, this->vValues, this->mValues);
+
+    int workerCount = this->pool == nullptr ? 1 : this->pool->threadCount;
+    auto avCountSet = std::vector<int>(workerCount, 0);
+
+    auto applyRange = [&](int t)
+    {
+        auto vRange = this->rangeOf(end - begin, t, workerCount);
+        int first = begin + vRange.first;
+        avCountSet.at(t) = this->executorOf(t).MSGApply_array(vRange.second - vRange.first, msgCount, this->vSet + first, this->numOfInitV, this->initVSet,
+                this->vValues + first * vLaneCount, this->mValues + first * mLaneCount);
+    };
+
+    if(this->pool == nullptr) applyRange(0);
+    else this->pool->run(applyRange);
+
+    int avCount = 0;
+    for(int c : avCountSet) avCount += c;
+
+    return avCount;
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+GraphUtilType &UtilServer<GraphUtilType, VertexValueType, MessageValueType>::executorOf(int workerID)
+{
+    return workerID == 0 ? this->executor : this->workerExecutors.at(workerID - 1);
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+MessageValueType *UtilServer<GraphUtilType, VertexValueType, MessageValueType>::mValuesOf(int workerID)
+{
+    return workerID == 0 ? this->mValues : this->workerMValues.at(workerID - 1).data();
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+std::pair<int, int> UtilServer<GraphUtilType, VertexValueType, MessageValueType>::rangeOf(int count, int partID, int partCount)
+{
+    return std::make_pair((int)((long long)count * partID / partCount), (int)((long long)count * (partID + 1) / partCount));
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+void UtilServer<GraphUtilType, VertexValueType, MessageValueType>::publishModifiedV()
+{
+    int laneCount = this->executor.totalVValuesCount / this->vCount;
+    int count = 0;
+
+    //Compared locally, so that only the list & the modified vertices are read by the client
+    for(int i = 0; i < this->vCount; i++)
+    {
+        bool isModified = this->vSet[i].isActive;
+        if(memcmp(&this->vValues[i * laneCount], &this->lastVValues[i * laneCount], laneCount * sizeof(VertexValueType)) != 0)
+        {
+            std::copy(&this->vValues[i * laneCount], &this->vValues[(i + 1) * laneCount], &this->lastVValues[i * laneCount]);
+            isModified = true;
+        }
+
+        if(isModified) this->modifiedVSet[count++] = i;
+    }
+
+    *this->modifiedVCount = count;
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+bool UtilServer<GraphUtilType, VertexValueType, MessageValueType>::isPeerSupported()
+{
+    //Messages from peers are merged, and every node applies its own vertices only
+    return this->nodeCount > 1 && this->nodeNo < this->nodeCount &&
+           this->executor.isMSGMergeable() && this->executor.isApplyVertexLocal();
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+void UtilServer<GraphUtilType, VertexValueType, MessageValueType>::peerConnect()
+{
+    int vLaneCount = this->executor.totalVValuesCount / this->vCount;
+    int mLaneCount = this->executor.totalMValuesCount / this->vCount;
+    auto ownedRange = this->rangeOf(this->vCount, this->nodeNo, this->nodeCount);
+
+    this->peerMSGOut_shm.assign(this->nodeCount, UNIX_shm());
+    this->peerMSGIn_shm.assign(this->nodeCount, UNIX_shm());
+    this->peerValueIn_shm.assign(this->nodeCount, UNIX_shm());
+    this->peerValueOut_shm = UNIX_shm();
+    this->peerBarrier = UNIX_barrier();
+
+    //Segments written by this node
+    for(int j = 0; j < this->nodeCount; j++)
+    {
+        if(j == this->nodeNo) continue;
+        auto range = this->rangeOf(this->vCount, j, this->nodeCount);
+        auto &shm = this->peerMSGOut_shm.at(j);
+        shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (PEERMSG_SHM << SHM_OFFSET) | (this->graphNo << GRAPH_OFFSET) | j),
+            peerBufferSize<MessageValueType>(range.second - range.first, mLaneCount),
+            0666);
+        shm.attach(0666);
+    }
+    this->peerValueOut_shm.create(((this->nodeNo << NODE_NUM_OFFSET) | (PEERVALUE_SHM << SHM_OFFSET) | (this->graphNo << GRAPH_OFFSET)),
+        peerBufferSize<VertexValueType>(ownedRange.second - ownedRange.first, vLaneCount),
+        0666);
+    this->peerValueOut_shm.attach(0666);
+    if(this->nodeNo == 0)
+        this->peerBarrier.create(((0 << NODE_NUM_OFFSET) | (PEERBARRIER_SHM << SHM_OFFSET) | (this->graphNo << GRAPH_OFFSET)), this->nodeCount, 0666);
+
+    //Segments of peers, which may be not created yet
+    for(int j = 0; j < this->nodeCount; j++)
+    {
+        if(j == this->nodeNo) continue;
+        while(this->peerMSGIn_shm.at(j).fetch(((j << NODE_NUM_OFFSET) | (PEERMSG_SHM << SHM_OFFSET) | (this->graphNo << GRAPH_OFFSET) | this->nodeNo)) == -1) usleep(1000);
+        this->peerMSGIn_shm.at(j).attach(0666);
+        while(this->peerValueIn_shm.at(j).fetch(((j << NODE_NUM_OFFSET) | (PEERVALUE_SHM << SHM_OFFSET) | (this->graphNo << GRAPH_OFFSET))) == -1) usleep(1000);
+        this->peerValueIn_shm.at(j).attach(0666);
+    }
+    if(this->nodeNo != 0)
+    {
+        while(this->peerBarrier.fetch(((0 << NODE_NUM_OFFSET) | (PEERBARRIER_SHM << SHM_OFFSET) | (this->graphNo << GRAPH_OFFSET))) == -1) usleep(1000);
+    }
+
+    //Messages generated without any edge
+    auto probe = this->executor;
+    auto probeV = Vertex(0, false, INVALID_INITV_INDEX);
+    auto probeVValue = std::vector<VertexValueType>(vLaneCount);
+    this->emptyMValue.assign(mLaneCount, MessageValueType());
+    probe.MSGGenMerge_array(1, 0, &probeV, nullptr, this->numOfInitV, this->initVSet, probeVValue.data(), this->emptyMValue.data());
+
+    this->isPeerConnected = true;
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+void UtilServer<GraphUtilType, VertexValueType, MessageValueType>::peerDisconnect()
+{
+    if(!this->isPeerConnected) return;
+
+    //Segments of peers are removed by their own creators
+    for(int j = 0; j < this->peerMSGOut_shm.size(); j++)
+    {
+        if(j == this->nodeNo) continue;
+        this->peerMSGOut_shm.at(j).detach();
+        this->peerMSGOut_shm.at(j).control(IPC_RMID);
+        this->peerMSGIn_shm.at(j).detach();
+        this->peerValueIn_shm.at(j).detach();
+    }
+    this->peerValueOut_shm.detach();
+    this->peerValueOut_shm.control(IPC_RMID);
+
+    this->peerBarrier.detach();
+    if(this->nodeNo == 0) this->peerBarrier.control(IPC_RMID);
+
+    this->isPeerConnected = false;
+}
+
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+int UtilServer<GraphUtilType, VertexValueType, MessageValueType>::peerStep()
+{
+    int vLaneCount = this->executor.totalVValuesCount / this->vCount;
+    int mLaneCount = this->executor.totalMValuesCount / this->vCount;
+    auto ownedRange = this->rangeOf(this->vCount, this->nodeNo, this->nodeCount);
+    int *header, *vIDs;
+    char *flags;
+    MessageValueType *mBuffer;
+    VertexValueType *vBuffer;
+
+    int msgCount = this->genMerge();
+
+    //Messages to vertices of every peer
+    for(int j = 0; j < this->nodeCount; j++)
+    {
+        if(j == this->nodeNo) continue;
+        auto range = this->rangeOf(this->vCount, j, this->nodeCount);
+        peerBufferOf(this->peerMSGOut_shm.at(j).shmaddr, range.second - range.first, &header, &vIDs, &flags, &mBuffer);
+
+        int count = 0;
+        for(int i = range.first; i < range.second; i++)
+        {
+            if(memcmp(&this->mValues[i * mLaneCount], this->emptyMValue.data(), mLaneCount * sizeof(MessageValueType)) == 0) continue;
+            vIDs[count] = i;
+            memcpy(&mBuffer[count * mLaneCount], &this->mValues[i * mLaneCount], mLaneCount * sizeof(MessageValueType));
+            count++;
+        }
+        header[0] = count;
+    }
+
+    this->peerBarrier.wait();
+
+    //Messages from every peer merged into owned vertices
+    for(int j = 0; j < this->nodeCount; j++)
+    {
+        if(j == this->nodeNo) continue;
+        peerBufferOf(this->peerMSGIn_shm.at(j).shmaddr, ownedRange.second - ownedRange.first, &header, &vIDs, &flags, &mBuffer);
+
+        for(int k = 0; k < header[0]; k++)
+            this->executor.MSGMerge_array(1, this->numOfInitV, &this->mValues[vIDs[k] * mLaneCount], &mBuffer[k * mLaneCount]);
+        msgCount += header[0];
+    }
+
+    this->ownedVValues.assign(&this->vValues[ownedRange.first * vLaneCount], &this->vValues[ownedRange.second * vLaneCount]);
+
+    int avCount = this->apply(ownedRange.first, ownedRange.second, msgCount);
+
+    //Owned vertices changed or active are published, and the others are known from their owners
+    peerBufferOf(this->peerValueOut_shm.shmaddr, ownedRange.second - ownedRange.first, &header, &vIDs, &flags, &vBuffer);
+    int count = 0;
+    for(int i = ownedRange.first; i < ownedRange.second; i++)
+    {
+        if(!this->vSet[i].isActive &&
+           memcmp(&this->vValues[i * vLaneCount], &this->ownedVValues[(i - ownedRange.first) * vLaneCount], vLaneCount * sizeof(VertexValueType)) == 0)
+            continue;
+        vIDs[count] = i;
+        flags[count] = this->vSet[i].isActive;
+        memcpy(&vBuffer[count * vLaneCount], &this->vValues[i * vLaneCount], vLaneCount * sizeof(VertexValueType));
+        count++;
+    }
+    header[0] = count;
+    header[1] = avCount;
+
+    for(int i = 0; i < ownedRange.first; i++) this->vSet[i].isActive = false;
+    for(int i = ownedRange.second; i < this->vCount; i++) this->vSet[i].isActive = false;
+
+    this->peerBarrier.wait();
+
+    for(int j = 0; j < this->nodeCount; j++)
+    {
+        if(j == this->nodeNo) continue;
+        auto range = this->rangeOf(this->vCount, j, this->nodeCount);
+        peerBufferOf(this->peerValueIn_shm.at(j).shmaddr, range.second - range.first, &header, &vIDs, &flags, &vBuffer);
+
+        for(int k = 0; k < header[0]; k++)
+        {
+            int vID = vIDs[k];
+            memcpy(&this->vValues[vID * vLaneCount], &vBuffer[k * vLaneCount], vLaneCount * sizeof(VertexValueType));
+            this->vSet[vID].isActive = flags[k];
+        }
+        avCount += header[1];
+    }
+
+    return avCount;
+}
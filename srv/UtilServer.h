@@ -10,20 +10,24 @@
 #include "../core/GraphUtil.h"
 #include "../srv/UNIX_shm.h"
 #include "../srv/UNIX_msg.h"
+#include "../srv/UNIX_doorbell.h"
+#include "../srv/UNIX_barrier.h"
+#include "../srv/WorkerPool.h"
 #include "../include/UNIX_marco.h"
 
+#include <memory>
+#include <map>
+
+//Executor & segments of one graph resident in a UtilServer
 template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
-class UtilServer
+class UtilServerGraph
 {
 public:
-    UtilServer(int vCount, int eCount, int numOfInitV, int nodeNo = 0);
-    ~UtilServer();
-
-    void run();
+    UtilServerGraph();
 
-    int nodeNo;
+    //Slot of the graph in the server, which is a part of its segment keys
+    int graphNo;
     GraphUtilType executor;
-    bool isLegal;
 
     int vCount;
     int eCount;
@@ -37,7 +41,13 @@ public:
     Vertex *vSet;
     Edge *eSet;
 
-private:
+    //Count at [0] followed by vertex IDs, see UtilClient
+    int *changedVCount;
+    int *changedVSet;
+    int *modifiedVCount;
+    int *modifiedVSet;
+
+protected:
     UNIX_shm initVSet_shm;
     UNIX_shm filteredV_shm;
     UNIX_shm filteredVCount_shm;
@@ -45,10 +55,94 @@ private:
     UNIX_shm mValues_shm;
     UNIX_shm vSet_shm;
     UNIX_shm eSet_shm;
+    UNIX_shm changedV_shm;
+    UNIX_shm modifiedV_shm;
+    //Sizes of segments above by their shm IDs, which are kept while graphs of the slot fit in them
+    std::vector<size_t> segmentCapacity;
+
+    //vValues as the client knows them: values before the step, synced with vertices changed by the client
+    std::vector<VertexValueType> lastVValues;
+
+    //Attached at the first PEER_RUN_CMD
+    //Messages to the owner of every vertex with them are written to peerMSGOut_shm[owner], and read from peerMSGIn_shm[sender]
+    //Values of owned vertices changed or active are written to peerValueOut_shm, and read from peerValueIn_shm[owner]
+    bool isPeerConnected;
+    std::vector<UNIX_shm> peerMSGOut_shm;
+    std::vector<UNIX_shm> peerMSGIn_shm;
+    UNIX_shm peerValueOut_shm;
+    std::vector<UNIX_shm> peerValueIn_shm;
+    UNIX_barrier peerBarrier;
+    //Messages of a vertex without any of them, which are not sent
+    std::vector<MessageValueType> emptyMValue;
+    std::vector<VertexValueType> ownedVValues;
+};
+
+//Graphs other than the one served are parked with their segments attached, and LOAD_CMD switches between them
+template <typename GraphUtilType, typename VertexValueType, typename MessageValueType>
+class UtilServer : public UtilServerGraph<GraphUtilType, VertexValueType, MessageValueType>
+{
+public:
+    //The graph of slot 0
+    UtilServer(int vCount, int eCount, int numOfInitV, int nodeNo = 0);
+    ~UtilServer();
+
+    void run();
+
+    int nodeNo;
+    bool isLegal;
+
+    //Threads of run(), 1 by default so that one server per core works as before
+    //Array kernels run on edge & vertex ranges in parallel only if the executor supports it (see GraphUtil::isMSGMergeable)
+    int threadCount;
+
+    //Servers of PEER_RUN_CMD, node nodeNo owns vertices of part nodeNo when vertices are divided into nodeCount parts
+    int nodeCount;
+
+private:
+    typedef UtilServerGraph<GraphUtilType, VertexValueType, MessageValueType> Graph_t;
+
+    UNIX_doorbell doorbell;
+    //Graph of LOAD_CMD
+    UNIX_shm loadInfo_shm;
+    LoadInfo *loadInfo;
 
-    UNIX_msg server_msq;
     UNIX_msg init_msq;
-    UNIX_msg client_msq;
+
+    std::map<int, Graph_t> parkedGraphs;
+
+    //Worker pool of run(), and copies of executor & mValues for every worker but the first one
+    std::shared_ptr<WorkerPool> pool;
+    std::vector<GraphUtilType> workerExecutors;
+    std::vector<std::vector<MessageValueType>> workerMValues;
+
+    key_t keyOf(int shmID);
+    //Segments of the graph served, re-created only if they are too small for it
+    int reserveSegments();
+    int reserveSegment(UNIX_shm &shm, int shmID, size_t size);
+    //Serves graphNo with the graph given, returning -1 if its segments cannot be created
+    int load(int graphNo, int vCount, int eCount, int numOfInitV);
+    void unload();
+    void setupWorkers();
+
+    void syncChangedV();
+    //MSGGenMerge_array & MSGApply_array, returning the count of active vertices
+    int step();
+    //MSGGenMerge_array of all edges into mValues
+    int genMerge();
+    //MSGApply_array of vertices [begin, end), which should be all of them unless the executor is vertex local
+    int apply(int begin, int end, int msgCount);
+
+    GraphUtilType &executorOf(int workerID);
+    MessageValueType *mValuesOf(int workerID);
+    //[begin, end) of part partID when count is divided into partCount parts
+    static std::pair<int, int> rangeOf(int count, int partID, int partCount);
+    void publishModifiedV();
+
+    bool isPeerSupported();
+    void peerConnect();
+    void peerDisconnect();
+    //Superstep of all nodes, returning the count of active vertices of the whole graph
+    int peerStep();
 };
 
 #endif //GRAPH_ALGO_UTILSERVER_H
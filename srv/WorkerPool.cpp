@@ -0,0 +1,70 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(int threadCount)
+{
+    this->threadCount = threadCount > 0 ? threadCount : 1;
+    this->task = nullptr;
+    this->generation = 0;
+    this->pendingCount = 0;
+    this->isStopping = false;
+
+    for(int i = 1; i < this->threadCount; i++)
+        this->threads.emplace_back(&WorkerPool::work, this, i);
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->isStopping = true;
+    }
+    this->taskCV.notify_all();
+
+    for(auto &t : this->threads) t.join();
+}
+
+void WorkerPool::run(const std::function<void(int)> &f)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->task = &f;
+        this->pendingCount = this->threadCount - 1;
+        this->generation++;
+    }
+    this->taskCV.notify_all();
+
+    f(0);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->doneCV.wait(lock, [this]{return this->pendingCount == 0;});
+    this->task = nullptr;
+}
+
+void WorkerPool::work(int threadID)
+{
+    long long lastGeneration = 0;
+
+    while(true)
+    {
+        const std::function<void(int)> *f;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->taskCV.wait(lock, [&]{return this->isStopping || this->generation != lastGeneration;});
+            if(this->isStopping) return;
+            lastGeneration = this->generation;
+            f = this->task;
+        }
+
+        (*f)(threadID);
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->pendingCount--;
+        }
+        this->doneCV.notify_one();
+    }
+}
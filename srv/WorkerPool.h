@@ -0,0 +1,43 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#pragma once
+
+#ifndef GRAPH_ALGO_WORKERPOOL_H
+#define GRAPH_ALGO_WORKERPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+//Threads kept between supersteps, which run one task at a time together
+class WorkerPool
+{
+public:
+    WorkerPool(int threadCount);
+    ~WorkerPool();
+
+    //f(threadID) for every threadID in [0, threadCount), and f(0) is run by the calling thread
+    //Returns after all of them finish
+    void run(const std::function<void(int)> &f);
+
+    int threadCount;
+
+private:
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable taskCV;
+    std::condition_variable doneCV;
+    const std::function<void(int)> *task;
+    long long generation;
+    int pendingCount;
+    bool isStopping;
+
+    void work(int threadID);
+};
+
+#endif //GRAPH_ALGO_WORKERPOOL_H
@@ -6,6 +6,8 @@
 
 #include "../../algo/BellmanFord/BellmanFord.h"
 #include "../../algo/LabelPropagation/LabelPropagation.h"
+#include "../../algo/PageRank/PageRank.h"
 
 template class UtilServer<BellmanFord<double, double>, double, double>;
-template class UtilServer<LabelPropagation<std::pair<int, int>, std::pair<int, int>>, std::pair<int, int>, std::pair<int, int>>;
\ No newline at end of file
+template class UtilServer<LabelPropagation<std::pair<int, int>, std::pair<int, int>>, std::pair<int, int>, std::pair<int, int>>;
+template class UtilServer<PageRank<PRValue, double>, PRValue, double>;
\ No newline at end of file
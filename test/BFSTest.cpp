@@ -0,0 +1,65 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../algo/BFS/BFS.h"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+
+int main()
+{
+    //Read the Graph
+    std::ifstream Gin("testGraph.txt");
+    if(!Gin.is_open()) {std::cout << "Error! File testGraph.txt not found!" << std::endl; return 1; }
+
+    int vCount, eCount;
+    Gin >> vCount >> eCount;
+
+    Graph<BFSValue> test = Graph<BFSValue>(vCount);
+    for(int i = 0; i < eCount; i++)
+    {
+        int src, dst;
+        double weight;
+
+        Gin >> src >> dst >> weight;
+        test.insertEdge(src, dst, weight);
+    }
+
+    Gin.close();
+
+    std::vector<int> initVList = std::vector<int>();
+    initVList.push_back(1);
+    initVList.push_back(2);
+    initVList.push_back(4);
+
+    BFS<BFSValue, int> executor = BFS<BFSValue, int>();
+
+    auto start = std::chrono::steady_clock::now();
+    //executor.Apply(test, initVList);
+    executor.ApplyD(test, initVList, 4);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for(int i = 0; i < test.vCount * initVList.size(); i++)
+    {
+        if(i % initVList.size() == 0) std::cout << i / initVList.size() << ": ";
+        std::cout << "(" << initVList.at(i % initVList.size()) << " -> parent " << test.verticesValue.at(i).parent << ", depth " << test.verticesValue.at(i).depth << ")";
+        if(i % initVList.size() == initVList.size() - 1) std::cout << std::endl;
+    }
+
+    //TEPS as in Graph500: edges out of reached vertices of every initV over the whole running time
+    long long traversedEdgeCount = 0;
+    for(const auto &e : test.eList)
+    {
+        for(int j = 0; j < initVList.size(); j++)
+        {
+            if(test.verticesValue.at(e.src * initVList.size() + j).depth != BFS_UNREACHED)
+                traversedEdgeCount++;
+        }
+    }
+
+    std::cout << "traversed edges: " << traversedEdgeCount << std::endl;
+    std::cout << "top-down levels: " << executor.topDownCount << ", bottom-up levels: " << executor.bottomUpCount << std::endl;
+    std::cout << "TEPS: " << (seconds > 0 ? traversedEdgeCount / seconds : 0) << std::endl;
+}
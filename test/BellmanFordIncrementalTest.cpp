@@ -0,0 +1,66 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../algo/BellmanFord/BellmanFord.h"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+
+int main()
+{
+    //Read the Graph
+    std::ifstream Gin("testGraph.txt");
+    if(!Gin.is_open()) {std::cout << "Error! File testGraph.txt not found!" << std::endl; return 1; }
+
+    int vCount, eCount;
+    Gin >> vCount >> eCount;
+
+    //The last tenth of edges is inserted in batches after the first result
+    Graph<double> test = Graph<double>(vCount);
+    std::vector<Edge> newEdges = std::vector<Edge>();
+    for(int i = 0; i < eCount; i++)
+    {
+        int src, dst;
+        double weight;
+
+        Gin >> src >> dst >> weight;
+        if(i < eCount - eCount / 10) test.insertEdge(src, dst, weight);
+        else newEdges.emplace_back(src, dst, weight);
+    }
+
+    Gin.close();
+
+    std::vector<int> initVList = std::vector<int>();
+    initVList.push_back(1);
+    initVList.push_back(2);
+    initVList.push_back(4);
+
+    BellmanFord<double, double> executor = BellmanFord<double, double>();
+    executor.Apply(test, initVList);
+
+    auto start = std::chrono::steady_clock::now();
+    int batchSize = 16;
+    for(int i = 0; i < newEdges.size(); i += batchSize)
+    {
+        auto batch = std::vector<Edge>(newEdges.begin() + i, newEdges.begin() + std::min(i + batchSize, (int)newEdges.size()));
+        executor.ApplyIncremental(test, initVList, batch);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    //Full recompute for comparison
+    Graph<double> full = Graph<double>(test.vList, test.eList, std::vector<double>());
+    executor.Apply(full, initVList);
+
+    int diffCount = 0;
+    for(int i = 0; i < test.vCount * initVList.size(); i++)
+    {
+        if(i % initVList.size() == 0) std::cout << i / initVList.size() << ": ";
+        std::cout << "(" << initVList.at(i % initVList.size()) << " -> " << test.verticesValue.at(i) << ")";
+        if(i % initVList.size() == initVList.size() - 1) std::cout << std::endl;
+        if(test.verticesValue.at(i) != full.verticesValue.at(i)) diffCount++;
+    }
+
+    std::cout << "incremental: " << newEdges.size() << " edges in " << seconds << "s, " << diffCount << " different from full recompute" << std::endl;
+}
@@ -0,0 +1,67 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../algo/ConnectedComponent/ConnectedComponent.h"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+
+int main()
+{
+    //Read the Graph
+    std::ifstream Gin("testGraph.txt");
+    if(!Gin.is_open()) {std::cout << "Error! File testGraph.txt not found!" << std::endl; return 1; }
+
+    int vCount, eCount;
+    Gin >> vCount >> eCount;
+
+    //The last tenth of edges is inserted in batches
+    Graph<int> test = Graph<int>(vCount);
+    std::vector<Edge> newEdges = std::vector<Edge>();
+    for(int i = 0; i < eCount; i++)
+    {
+        int src, dst;
+        double weight;
+
+        Gin >> src >> dst >> weight;
+        if(i < eCount - eCount / 10) test.insertEdge(src, dst, weight);
+        else newEdges.emplace_back(src, dst, weight);
+    }
+
+    Gin.close();
+
+    std::vector<int> initVList = std::vector<int>();
+
+    ConnectedComponent<int, int> executor = ConnectedComponent<int, int>();
+
+    auto start = std::chrono::steady_clock::now();
+    int batchSize = 16;
+    for(int i = 0; i < newEdges.size(); i += batchSize)
+    {
+        auto batch = std::vector<Edge>(newEdges.begin() + i, newEdges.begin() + std::min(i + batchSize, (int)newEdges.size()));
+        executor.ApplyIncremental(test, batch);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    executor.ExportComponents(test);
+
+    //Full recompute for comparison, on edges of both directions
+    Graph<int> full = Graph<int>(vCount);
+    for(const auto &e : test.eList)
+    {
+        full.insertEdge(e.src, e.dst, e.weight);
+        full.insertEdge(e.dst, e.src, e.weight);
+    }
+    executor.Apply(full, initVList);
+
+    int diffCount = 0;
+    for(int i = 0; i < test.vCount; i++)
+    {
+        std::cout << i << ": " << test.verticesValue.at(i) << std::endl;
+        if(test.verticesValue.at(i) != full.verticesValue.at(i)) diffCount++;
+    }
+
+    std::cout << "incremental: " << newEdges.size() << " edges in " << seconds << "s (including the first build), " << diffCount << " different from full recompute" << std::endl;
+}
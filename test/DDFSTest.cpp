@@ -0,0 +1,154 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../algo/DDFS/DDFS.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+//Roots which reach every vertex through edges of either direction
+static std::vector<std::vector<int>> reachingRoots(const Graph<DFSValue> &g, const std::vector<int> &initVList)
+{
+    auto related = std::vector<std::vector<int>>(g.vCount);
+    for(const auto &e : g.eList)
+    {
+        if(e.src == e.dst) continue;
+        related.at(e.src).emplace_back(e.dst);
+        related.at(e.dst).emplace_back(e.src);
+    }
+
+    auto res = std::vector<std::vector<int>>(g.vCount);
+    for(int initV : initVList)
+    {
+        auto isReached = std::vector<char>(g.vCount, false);
+        auto queue = std::deque<int>();
+        queue.emplace_back(initV);
+        isReached.at(initV) = true;
+        while(!queue.empty())
+        {
+            int v = queue.front();
+            queue.pop_front();
+            res.at(v).emplace_back(initV);
+            for(int r : related.at(v))
+            {
+                if(isReached.at(r)) continue;
+                isReached.at(r) = true;
+                queue.emplace_back(r);
+            }
+        }
+    }
+
+    return res;
+}
+
+//Checks that the result is a forest of DFS trees, one per root, covering exactly the vertices reached by roots
+//Returns the count of bad vertices
+static int checkForest(const Graph<DFSValue> &g, const std::vector<int> &initVList, const std::vector<std::vector<int>> &roots)
+{
+    auto isEdge = [&](int a, int b)
+    {
+        for(const auto &e : g.eList)
+            if((e.src == a && e.dst == b) || (e.src == b && e.dst == a)) return true;
+        return false;
+    };
+
+    int badCount = 0;
+    for(int i = 0; i < g.vCount; i++)
+    {
+        const auto &vV = g.verticesValue.at(i);
+        bool isRoot = std::find(initVList.begin(), initVList.end(), i) != initVList.end();
+        bool isGood;
+        if(roots.at(i).empty()) isGood = vV.state == STATE_IDLE && vV.vRoot == -1;
+        else if(isRoot) isGood = vV.state == STATE_DISCOVERED && vV.vRoot == i && vV.vParent == -1;
+        else isGood = vV.state == STATE_DISCOVERED && vV.vParent != -1 &&
+                      std::find(roots.at(i).begin(), roots.at(i).end(), vV.vRoot) != roots.at(i).end() &&
+                      g.verticesValue.at(vV.vParent).vRoot == vV.vRoot && isEdge(i, vV.vParent);
+
+        if(!isGood)
+        {
+            std::cout << "Bad vertex " << i << " (root " << vV.vRoot << ", parent " << vV.vParent << ")" << std::endl;
+            badCount++;
+        }
+    }
+
+    return badCount;
+}
+
+int main()
+{
+    //Read the Graph
+    std::ifstream Gin("testGraph.txt");
+    if(!Gin.is_open()) {std::cout << "Error! File testGraph.txt not found!" << std::endl; return 1; }
+
+    int vCount, eCount;
+    Gin >> vCount >> eCount;
+
+    //Two more vertices apart from the graph read, so that one root is unreachable from the others
+    Graph<DFSValue> test = Graph<DFSValue>(vCount + 2);
+    for(int i = 0; i < eCount; i++)
+    {
+        int src, dst;
+        double weight;
+
+        Gin >> src >> dst >> weight;
+        test.insertEdge(src, dst, weight);
+    }
+    test.insertEdge(vCount, vCount + 1, 1);
+
+    Gin.close();
+
+    //Roots: 0, the last vertex reached from 0 and the one unreachable from 0
+    std::vector<int> initVList = std::vector<int>();
+    initVList.push_back(0);
+    auto roots = reachingRoots(test, initVList);
+    int farthest = 0;
+    for(int i = 0; i < test.vCount; i++)
+        if(!roots.at(i).empty() && i != 0) farthest = i;
+    if(farthest != 0) initVList.push_back(farthest);
+    initVList.push_back(vCount + 1);
+    roots = reachingRoots(test, initVList);
+
+    DDFS<DFSValue, DFSMSG> executor = DDFS<DFSValue, DFSMSG>();
+    //executor.Apply(test, initVList);
+    executor.ApplyD(test, initVList, 4);
+
+    for(int i = 0; i < test.vCount; i++)
+        std::cout << i << ": " << (test.verticesValue.at(i).state == STATE_DISCOVERED ? "discovered" : "idle") << " (root " << test.verticesValue.at(i).vRoot << ", parent " << test.verticesValue.at(i).vParent << ")" << std::endl;
+
+    int badCount = checkForest(test, initVList, roots);
+    for(int initV : initVList)
+        std::cout << "Tree of root " << initV << ": " << std::count_if(test.verticesValue.begin(), test.verticesValue.end(), [&](const DFSValue &vV){return vV.vRoot == initV;}) << " vertices" << std::endl;
+
+    //Roots 0 and 2 both take vertex 1 as their first son in the first superstep
+    //Vertex 1 and what follows it should be owned by the lower root, on one subgraph (token order) and on several (MergeGraph)
+    //Root 5 is unreachable from them
+    for(int partitionCount : {1, 4})
+    {
+        auto contest = Graph<DFSValue>(6);
+        contest.insertEdge(0, 1, 1);
+        contest.insertEdge(2, 1, 1);
+        contest.insertEdge(1, 3, 1);
+        contest.insertEdge(4, 5, 1);
+        auto contestInitVList = std::vector<int>{0, 2, 5};
+
+        executor.ApplyD(contest, contestInitVList, partitionCount);
+
+        badCount += checkForest(contest, contestInitVList, reachingRoots(contest, contestInitVList));
+        for(int v : {1, 3})
+        {
+            if(contest.verticesValue.at(v).vRoot != 0)
+            {
+                std::cout << "Contested vertex " << v << " owned by root " << contest.verticesValue.at(v).vRoot << " on " << partitionCount << " subgraph(s)" << std::endl;
+                badCount++;
+            }
+        }
+    }
+
+    std::cout << "Bad vertices: " << badCount << std::endl;
+
+    return badCount == 0 ? 0 : 2;
+}
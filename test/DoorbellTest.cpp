@@ -0,0 +1,84 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../srv/UNIX_doorbell.h"
+#include "../srv/UNIX_msg.h"
+#include "../include/UNIX_marco.h"
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <unistd.h>
+#include <sys/wait.h>
+
+//Round trip latency of the doorbell and of the msq handshake it replaced, between two processes
+int main(int argc, char *argv[])
+{
+    int roundCount = (argc == 2) ? atoi(argv[1]) : 100000;
+
+    UNIX_doorbell doorbell = UNIX_doorbell();
+    UNIX_msg server_msq = UNIX_msg();
+    UNIX_msg client_msq = UNIX_msg();
+    if(doorbell.create(UNIX_doorbell::testDoorbellKey, 0666) == -1 ||
+       server_msq.create(UNIX_msg::testMSGKey, 0666) == -1 ||
+       client_msq.create(UNIX_msg::testMSGKey + 1, 0666) == -1)
+    {
+        //Leftovers of a killed run are removed, so that the next run can start
+        std::cout << "shm or msq is occupied! Removed them, please run again" << std::endl;
+        if(doorbell.fetch(UNIX_doorbell::testDoorbellKey) != -1)
+        {
+            doorbell.detach();
+            doorbell.control(IPC_RMID);
+        }
+        if(server_msq.fetch(UNIX_msg::testMSGKey) != -1) server_msq.control(IPC_RMID);
+        if(client_msq.fetch(UNIX_msg::testMSGKey + 1) != -1) client_msq.control(IPC_RMID);
+        return 1;
+    }
+
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        //Server side
+        //The doorbell attached before fork is inherited, since rings before fetching again would be lost
+        while(doorbell.recv(DOORBELL_CLI_CHANNEL) == EXECUTE_CMD)
+            doorbell.send(DOORBELL_SRV_CHANNEL, FINISHED_CMD);
+
+        char msgp[256];
+        while(client_msq.recv(msgp, (CLI_MSG_TYPE << MSG_TYPE_OFFSET), 256) != -1 && std::string("execute") == msgp)
+            server_msq.send("finished", (SRV_MSG_TYPE << MSG_TYPE_OFFSET), 256);
+
+        _exit(0);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < roundCount; i++)
+    {
+        doorbell.send(DOORBELL_CLI_CHANNEL, EXECUTE_CMD);
+        doorbell.recv(DOORBELL_SRV_CHANNEL);
+    }
+    auto doorbellTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    doorbell.send(DOORBELL_CLI_CHANNEL, EXIT_CMD);
+
+    char tmp[256];
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < roundCount; i++)
+    {
+        client_msq.send("execute", (CLI_MSG_TYPE << MSG_TYPE_OFFSET), 256);
+        server_msq.recv(tmp, (SRV_MSG_TYPE << MSG_TYPE_OFFSET), 256);
+    }
+    auto msqTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    client_msq.send("exit", (CLI_MSG_TYPE << MSG_TYPE_OFFSET), 256);
+
+    waitpid(pid, nullptr, 0);
+
+    std::cout << "doorbell: " << doorbellTime / roundCount << "us per round trip" << std::endl;
+    std::cout << "msq: " << msqTime / roundCount << "us per round trip" << std::endl;
+
+    doorbell.detach();
+    doorbell.control(IPC_RMID);
+    server_msq.control(IPC_RMID);
+    client_msq.control(IPC_RMID);
+
+    return 0;
+}
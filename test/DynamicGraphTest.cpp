@@ -0,0 +1,84 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../core/DynamicGraph.h"
+
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include <ctime>
+
+int main()
+{
+    std::ifstream Gin("testGraph.txt");
+    if(!Gin.is_open()) {std::cout << "Error! File testGraph.txt not found!" << std::endl; return 1; }
+
+    int vCount, eCount;
+    Gin >> vCount >> eCount;
+
+    auto test = AbstractGraph(vCount);
+    for(int i = 0; i < eCount; i++)
+    {
+        int src, dst;
+        double weight;
+
+        Gin >> src >> dst >> weight;
+        test.insertEdge(src, dst, weight);
+    }
+
+    Gin.close();
+
+    auto dynamicG = DynamicGraph(test);
+
+    //Reference: the same updates on a plain edge list
+    auto refEdges = test.eList;
+
+    std::default_random_engine e(1);
+    std::uniform_int_distribution<int> vDist(0, vCount - 1);
+
+    int batchSize = std::max(1, eCount / 20);
+    int batchCount = 10;
+
+    clock_t updateTime = 0;
+
+    for(int b = 0; b < batchCount; b++)
+    {
+        auto insertBatch = std::vector<Edge>();
+        for(int i = 0; i < batchSize; i++) insertBatch.emplace_back(vDist(e), vDist(e), b);
+
+        auto deleteBatch = std::vector<Edge>();
+        for(int i = 0; i < batchSize && !refEdges.empty(); i++)
+            deleteBatch.emplace_back(refEdges.at(std::uniform_int_distribution<int>(0, refEdges.size() - 1)(e)));
+
+        auto start = clock();
+        dynamicG.insertEdges(insertBatch);
+        dynamicG.deleteEdges(deleteBatch);
+        updateTime += clock() - start;
+
+        refEdges.insert(refEdges.end(), insertBatch.begin(), insertBatch.end());
+        for(const auto &d : deleteBatch)
+            refEdges.erase(std::remove_if(refEdges.begin(), refEdges.end(), [&](const Edge &x){return x.src == d.src && x.dst == d.dst;}), refEdges.end());
+    }
+
+    //Compare as multisets of (src, dst, weight)
+    auto key = [](const Edge &a, const Edge &b){return a.src != b.src ? a.src < b.src : a.dst != b.dst ? a.dst < b.dst : a.weight < b.weight;};
+    auto edges = dynamicG.getEdgeList();
+    std::sort(edges.begin(), edges.end(), key);
+    std::sort(refEdges.begin(), refEdges.end(), key);
+
+    bool isSame = edges.size() == refEdges.size() && dynamicG.eCount == refEdges.size();
+    for(int i = 0; isSame && i < edges.size(); i++)
+        isSame = edges.at(i).src == refEdges.at(i).src && edges.at(i).dst == refEdges.at(i).dst && edges.at(i).weight == refEdges.at(i).weight;
+
+    long long degreeSum = 0;
+    for(int v = 0; v < vCount; v++) dynamicG.forEachOutEdge(v, [&](int dst, double weight){degreeSum++;});
+    isSame = isSame && degreeSum == refEdges.size();
+
+    std::cout << "eCount: " << dynamicG.eCount << " delta: " << dynamicG.deltaCount << " tombstones: " << dynamicG.tombstoneCount << std::endl;
+    std::cout << (isSame ? "match" : "mismatch") << std::endl;
+    std::cout << "Update time: " << (double)updateTime / CLOCKS_PER_SEC << "s" << std::endl;
+
+    return isSame ? 0 : 1;
+}
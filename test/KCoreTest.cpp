@@ -0,0 +1,107 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../algo/KCore/KCore.h"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <set>
+
+//Cores by sequential peeling on the undirected & deduplicated graph, as the reference
+//The vertex of the smallest remaining degree is removed each time, and its core is the largest such degree seen so far
+static std::vector<int> referenceCores(int vCount, const std::vector<Edge> &eSet)
+{
+    auto adj = std::vector<std::set<int>>(vCount);
+    for(const auto &e : eSet)
+    {
+        if(e.src == e.dst) continue;
+        adj.at(e.src).insert(e.dst);
+        adj.at(e.dst).insert(e.src);
+    }
+
+    auto degree = std::vector<int>(vCount);
+    auto queue = std::set<std::pair<int, int>>();
+    for(int i = 0; i < vCount; i++)
+    {
+        degree.at(i) = adj.at(i).size();
+        queue.emplace(degree.at(i), i);
+    }
+
+    auto res = std::vector<int>(vCount, 0);
+    auto isRemoved = std::vector<char>(vCount, false);
+    int core = 0;
+    while(!queue.empty())
+    {
+        auto top = *queue.begin();
+        queue.erase(queue.begin());
+
+        int v = top.second;
+        core = std::max(core, top.first);
+        res.at(v) = core;
+        isRemoved.at(v) = true;
+
+        for(int u : adj.at(v))
+        {
+            if(isRemoved.at(u)) continue;
+            queue.erase({degree.at(u), u});
+            queue.emplace(--degree.at(u), u);
+        }
+    }
+
+    return res;
+}
+
+int main()
+{
+    //Read the Graph
+    std::ifstream Gin("testGraph.txt");
+    if(!Gin.is_open()) {std::cout << "Error! File testGraph.txt not found!" << std::endl; return 1; }
+
+    int vCount, eCount;
+    Gin >> vCount >> eCount;
+
+    Graph<int> test = Graph<int>(vCount);
+    for(int i = 0; i < eCount; i++)
+    {
+        int src, dst;
+        double weight;
+
+        Gin >> src >> dst >> weight;
+        test.insertEdge(src, dst, weight);
+    }
+
+    Gin.close();
+
+    std::vector<int> initVList = std::vector<int>();
+
+    auto cores = referenceCores(test.vCount, test.eList);
+    auto applyTest = test;
+
+    KCore<int, int> executor = KCore<int, int>();
+
+    executor.Apply(applyTest, initVList);
+
+    auto start = std::chrono::steady_clock::now();
+    executor.ApplyD(test, initVList, 4);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int maxCore = 0;
+    int mismatchCount = 0;
+    for(int i = 0; i < test.vCount; i++)
+    {
+        std::cout << i << ": " << test.verticesValue.at(i) << std::endl;
+        if(maxCore < test.verticesValue.at(i)) maxCore = test.verticesValue.at(i);
+        if(applyTest.verticesValue.at(i) != cores.at(i)) mismatchCount++;
+        if(test.verticesValue.at(i) != cores.at(i)) mismatchCount++;
+    }
+
+    //Power-law graphs can be generated by tool_RandGraphGen with rmat
+    std::cout << "max core: " << maxCore << std::endl;
+    std::cout << "time: " << seconds << "s" << std::endl;
+    std::cout << "Mismatched cores (Apply & ApplyD): " << mismatchCount << std::endl;
+
+    return mismatchCount == 0 ? 0 : 2;
+}
@@ -0,0 +1,55 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../algo/PageRank/PageRank.h"
+
+#include <iostream>
+#include <fstream>
+#include <cmath>
+
+int main()
+{
+    //Read the Graph
+    std::ifstream Gin("testGraph.txt");
+    if(!Gin.is_open()) {std::cout << "Error! File testGraph.txt not found!" << std::endl; return 1; }
+
+    int vCount, eCount;
+    Gin >> vCount >> eCount;
+
+    Graph<PRValue> test = Graph<PRValue>(vCount);
+    for(int i = 0; i < eCount; i++)
+    {
+        int src, dst;
+        double weight;
+
+        Gin >> src >> dst >> weight;
+        test.insertEdge(src, dst, weight);
+    }
+
+    Gin.close();
+
+    std::vector<int> initVList = std::vector<int>();
+
+    auto deltaTest = test;
+
+    PageRank<PRValue, double> executor = PageRank<PRValue, double>();
+    //executor.Apply(test, initVList);
+    executor.ApplyD(test, initVList, 4);
+
+    for(int i = 0; i < test.vCount; i++)
+        std::cout << i << ": " << test.verticesValue.at(i).rank << std::endl;
+
+    //Both modes stop at changes of epsilon / N, so their ranks should agree relatively for any N
+    executor.isDeltaMode = true;
+    executor.ApplyD(deltaTest, initVList, 4);
+
+    double maxRelDiff = 0;
+    for(int i = 0; i < test.vCount; i++)
+    {
+        double rank = test.verticesValue.at(i).rank;
+        double relDiff = std::fabs(deltaTest.verticesValue.at(i).rank - rank) / rank;
+        if(maxRelDiff < relDiff) maxRelDiff = relDiff;
+    }
+    std::cout << "Max relative difference of delta mode: " << maxRelDiff << std::endl;
+}
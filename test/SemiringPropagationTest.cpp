@@ -0,0 +1,103 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../algo/SemiringPropagation/SemiringPropagation.h"
+
+#include <iostream>
+#include <fstream>
+
+template <typename VertexValueType, typename SemiringType>
+void runAndPrint(const char *name, Graph<VertexValueType> test, const std::vector<int> &initVList)
+{
+    auto executor = SemiringPropagation<VertexValueType, SemiringType>();
+    //executor.Apply(test, initVList);
+    executor.ApplyD(test, initVList, 4);
+
+    std::cout << name << std::endl;
+    for(int i = 0; i < test.vCount * initVList.size(); i++)
+    {
+        if(i % initVList.size() == 0) std::cout << i / initVList.size() << ": ";
+        std::cout << "(" << initVList.at(i % initVList.size()) << " -> " << test.verticesValue.at(i) << ")";
+        if(i % initVList.size() == initVList.size() - 1) std::cout << std::endl;
+    }
+}
+
+//Runs on array kernels of one executor twice, as an executor of UtilServer does for jobs on the same edges
+//The second run should be the same as the first one, with states of the first run dropped by ResetRunState
+template <typename VertexValueType, typename SemiringType>
+void rerunAndCheck(const char *name, const Graph<VertexValueType> &test, const std::vector<int> &initVList)
+{
+    auto executor = SemiringPropagation<VertexValueType, SemiringType>();
+    int numOfInitV = initVList.size();
+    executor.Init(test.vCount, test.eCount, numOfInitV);
+    executor.Deploy(test.vCount, test.eCount, numOfInitV);
+
+    auto mValues = std::vector<VertexValueType>(test.vCount * numOfInitV);
+    auto resultSet = std::vector<std::vector<VertexValueType>>();
+    for(int run = 0; run < 2; run++)
+    {
+        auto g = test;
+        auto activeVertices = std::set<int>();
+        executor.GraphInit(g, activeVertices, initVList);
+        executor.ResetRunState();
+
+        int avCount = activeVertices.size();
+        while(avCount > 0)
+        {
+            executor.MSGGenMerge_array(g.vCount, g.eCount, &g.vList[0], &g.eList[0], numOfInitV, &initVList[0], &g.verticesValue[0], &mValues[0]);
+            avCount = executor.MSGApply_array(g.vCount, g.eCount, &g.vList[0], numOfInitV, &initVList[0], &g.verticesValue[0], &mValues[0]);
+        }
+
+        resultSet.emplace_back(g.verticesValue);
+    }
+
+    executor.Free();
+
+    int mismatchCount = 0;
+    for(int i = 0; i < resultSet.at(0).size(); i++)
+    {
+        if(resultSet.at(0).at(i) != resultSet.at(1).at(i)) mismatchCount++;
+    }
+    std::cout << name << " rerun mismatched values: " << mismatchCount << std::endl;
+}
+
+int main()
+{
+    //Read the Graph
+    std::ifstream Gin("testGraph.txt");
+    if(!Gin.is_open()) {std::cout << "Error! File testGraph.txt not found!" << std::endl; return 1; }
+
+    int vCount, eCount;
+    Gin >> vCount >> eCount;
+
+    Graph<double> test = Graph<double>(vCount);
+    //Weights of the walk sum are scaled to damping / out-degree as PageRank does
+    Graph<double> walkTest = Graph<double>(vCount);
+    auto outDegree = std::vector<int>(vCount, 0);
+    for(int i = 0; i < eCount; i++)
+    {
+        int src, dst;
+        double weight;
+
+        Gin >> src >> dst >> weight;
+        test.insertEdge(src, dst, weight);
+        outDegree.at(src)++;
+    }
+
+    Gin.close();
+
+    for(const auto &e : test.eList) walkTest.insertEdge(e.src, e.dst, 0.85 / outDegree.at(e.src));
+
+    std::vector<int> initVList = std::vector<int>();
+    initVList.push_back(1);
+    initVList.push_back(2);
+    initVList.push_back(4);
+
+    runAndPrint<double, MinPlusSemiring<double>>("Shortest path", test, initVList);
+    runAndPrint<double, MaxMinSemiring<double>>("Widest path", test, initVList);
+    runAndPrint<double, SumSemiring<double>>("Walk sum", walkTest, initVList);
+
+    rerunAndCheck<double, MinPlusSemiring<double>>("Shortest path", test, initVList);
+    rerunAndCheck<double, SumSemiring<double>>("Walk sum", walkTest, initVList);
+}
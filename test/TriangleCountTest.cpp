@@ -0,0 +1,109 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../algo/TriangleCount/TriangleCount.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <set>
+#include <cmath>
+
+//Triangles of every vertex by brute force on the undirected & deduplicated graph, as the reference
+static std::vector<long long> referenceTriangles(int vCount, const std::vector<Edge> &eSet, std::vector<std::set<int>> &adj)
+{
+    adj.assign(vCount, std::set<int>());
+    for(const auto &e : eSet)
+    {
+        if(e.src == e.dst) continue;
+        adj.at(e.src).insert(e.dst);
+        adj.at(e.dst).insert(e.src);
+    }
+
+    //Every triangle u < v < w is found once
+    auto res = std::vector<long long>(vCount, 0);
+    for(int u = 0; u < vCount; u++)
+    {
+        for(int v : adj.at(u))
+        {
+            if(v <= u) continue;
+            for(int w : adj.at(v))
+            {
+                if(w <= v || adj.at(u).count(w) == 0) continue;
+                res.at(u)++;
+                res.at(v)++;
+                res.at(w)++;
+            }
+        }
+    }
+
+    return res;
+}
+
+//Returns the count of vertices whose degree, triangles or clustering coefficient differs from the reference
+static int countMismatches(const Graph<TCValue> &g, const std::vector<long long> &triangles, const std::vector<std::set<int>> &adj)
+{
+    int mismatchCount = 0;
+    for(int i = 0; i < g.vCount; i++)
+    {
+        const auto &vV = g.verticesValue.at(i);
+        int degree = adj.at(i).size();
+        double coefficient = degree > 1 ? 2.0 * triangles.at(i) / ((double)degree * (degree - 1)) : 0;
+        if(vV.degree != degree || vV.triangleCount != triangles.at(i) || std::fabs(vV.clusteringCoefficient - coefficient) > 1e-12)
+            mismatchCount++;
+    }
+
+    return mismatchCount;
+}
+
+int main()
+{
+    //Read the Graph
+    std::ifstream Gin("testGraph.txt");
+    if(!Gin.is_open()) {std::cout << "Error! File testGraph.txt not found!" << std::endl; return 1; }
+
+    int vCount, eCount;
+    Gin >> vCount >> eCount;
+
+    Graph<TCValue> test = Graph<TCValue>(vCount);
+    for(int i = 0; i < eCount; i++)
+    {
+        int src, dst;
+        double weight;
+
+        Gin >> src >> dst >> weight;
+        test.insertEdge(src, dst, weight);
+    }
+
+    Gin.close();
+
+    //Reversed duplicates of some edges and a self loop, which should be ignored
+    for(int i = 0; i < std::min(eCount, 16); i++)
+        test.insertEdge(test.eList.at(i).dst, test.eList.at(i).src, test.eList.at(i).weight);
+    if(vCount > 0) test.insertEdge(0, 0, 1);
+
+    std::vector<int> initVList = std::vector<int>();
+
+    auto adj = std::vector<std::set<int>>();
+    auto triangles = referenceTriangles(test.vCount, test.eList, adj);
+
+    auto applyTest = test;
+
+    TriangleCount<TCValue, long long> executor = TriangleCount<TCValue, long long>();
+    executor.Apply(applyTest, initVList);
+    executor.ApplyD(test, initVList, 4);
+
+    long long triangleCount = 0;
+    for(int i = 0; i < test.vCount; i++)
+    {
+        std::cout << i << ": " << test.verticesValue.at(i).triangleCount << " " << test.verticesValue.at(i).clusteringCoefficient << std::endl;
+        triangleCount += test.verticesValue.at(i).triangleCount;
+    }
+    std::cout << "triangles: " << triangleCount / 3 << std::endl;
+
+    int mismatchCount = countMismatches(applyTest, triangles, adj) + countMismatches(test, triangles, adj);
+    std::cout << "Mismatched vertices (Apply & ApplyD): " << mismatchCount << std::endl;
+
+    return mismatchCount == 0 ? 0 : 2;
+}
@@ -12,23 +12,60 @@
 #include <fstream>
 #include <vector>
 
-#include <future>
 #include <cstring>
+#include <string>
+#include <thread>
+#include <deque>
+#include <cmath>
 
-template <typename VertexValueType, typename MessageValueType>
-void testFut(UtilClient<VertexValueType, MessageValueType> *uc, double *vValues, Vertex *vSet)
+//Distances from src by label correcting on the whole edge list, as the reference of queries
+static std::vector<double> referenceDistances(int vCount, const std::vector<Edge> &eSet, int src)
 {
-    uc->connect();
-    uc->update(vValues, vSet);
-    uc->request();
-    uc->disconnect();
+    auto offset = std::vector<int>(vCount + 1, 0);
+    for(const auto &e : eSet) offset.at(e.src + 1)++;
+    for(int i = 0; i < vCount; i++) offset.at(i + 1) += offset.at(i);
+    auto outEdges = std::vector<int>(eSet.size());
+    auto pos = offset;
+    for(int i = 0; i < eSet.size(); i++) outEdges.at(pos.at(eSet.at(i).src)++) = i;
+
+    auto dist = std::vector<double>(vCount, INT32_MAX >> 1);
+    auto isQueued = std::vector<char>(vCount, false);
+    auto queue = std::deque<int>();
+    dist.at(src) = 0;
+    queue.emplace_back(src);
+    isQueued.at(src) = true;
+    while(!queue.empty())
+    {
+        int v = queue.front();
+        queue.pop_front();
+        isQueued.at(v) = false;
+
+        for(int k = offset.at(v); k < offset.at(v + 1); k++)
+        {
+            const auto &e = eSet.at(outEdges.at(k));
+            if(dist.at(v) + e.weight < dist.at(e.dst))
+            {
+                dist.at(e.dst) = dist.at(v) + e.weight;
+                if(!isQueued.at(e.dst))
+                {
+                    queue.emplace_back(e.dst);
+                    isQueued.at(e.dst) = true;
+                }
+            }
+        }
+    }
+
+    return dist;
 }
 
+//Modified vertices of all nodes above vCount / GATHER_DENSE_RATIO are gathered by UtilClient::gather
+#define GATHER_DENSE_RATIO 8
+
 int main(int argc, char *argv[])
 {
-    if(argc != 4 && argc != 5)
+    if(argc < 4 || argc > 6 || (argc == 6 && std::string("converge") != argv[5] && std::string("peer") != argv[5] && std::string("load") != argv[5] && std::string("query") != argv[5]))
     {
-        std::cout << "Usage:" << std::endl << "./UtilClientTest_BellmanFord vCount eCount numOfInitV [nodeCount]" << std::endl;
+        std::cout << "Usage:" << std::endl << "./UtilClientTest_BellmanFord vCount eCount numOfInitV [nodeCount] [converge|peer|load|query]" << std::endl;
         return 1;
     }
 
@@ -36,9 +73,19 @@ int main(int argc, char *argv[])
     int eCount = atoi(argv[2]);
     int numOfInitV = atoi(argv[3]);
     int nodeCount = (argc == 4) ? 1 : atoi(argv[4]);
+    //Supersteps are run by the server alone, for a single node only
+    bool isConvergeMode = argc == 6 && std::string("converge") == argv[5];
+    //Supersteps are run by servers exchanging boundary values with each other, started with nodeCount of them
+    bool isPeerMode = argc == 6 && std::string("peer") == argv[5];
+    //The graph is loaded into slot 1 of servers started for any graph, which switches them to it
+    bool isLoadMode = argc == 6 && std::string("load") == argv[5];
+    //Sources of initVSet are queried a few times over, in batches of numOfInitV lanes on edges kept by servers
+    bool isQueryMode = argc == 6 && std::string("query") == argv[5];
+    //Supersteps driven by the client, whose segments stay attached, and data of every node is transferred in its first superstep
+    bool isPipelined = !isConvergeMode && !isPeerMode && !isQueryMode;
 
     //Parameter check
-    if(vCount <= 0 || eCount <= 0 || numOfInitV <= 0 || nodeCount <= 0)
+    if(vCount <= 0 || eCount <= 0 || numOfInitV <= 0 || nodeCount <= 0 || (isConvergeMode && nodeCount != 1))
     {
         std::cout << "Parameter illegal" << std::endl;
         return 3;
@@ -105,10 +152,16 @@ int main(int argc, char *argv[])
     //Client Init Data Transfer
     auto clientVec = std::vector<UtilClient<double, double>>();
     for(int i = 0; i < nodeCount; i++)
-        clientVec.push_back(UtilClient<double, double>(vCount, ((i + 1) * eCount) / nodeCount - (i * eCount) / nodeCount, numOfInitV, i));
+        clientVec.push_back(UtilClient<double, double>(vCount, ((i + 1) * eCount) / nodeCount - (i * eCount) / nodeCount, numOfInitV, i, isLoadMode ? 1 : 0));
     int chk = 0;
     for(int i = 0; i < nodeCount && chk != -1; i++)
     {
+        if(isLoadMode && clientVec.at(i).load() == -1)
+        {
+            std::cout << "Cannot load the graph into server correctly" << std::endl;
+            return 2;
+        }
+
         chk = clientVec.at(i).connect();
         if (chk == -1)
         {
@@ -116,6 +169,8 @@ int main(int argc, char *argv[])
             return 2;
         }
 
+        if(isPipelined) continue;
+
         chk = clientVec.at(i).transfer(vValues, &vSet[0], &eSet[(i * eCount) / nodeCount], initVSet, filteredV, vCount);
 
         if(chk == -1)
@@ -131,12 +186,111 @@ int main(int argc, char *argv[])
     for(int i = 0; i < vCount; i++) isActive |= vSet[i].isActive;
 
     bool *ret_AVCheckSet = new bool [vCount];
+    WorkerPool gatherPool(std::max(1U, std::thread::hardware_concurrency()));
     int iterCount = 0;
 
+    //Vertices modified by any server in the last iteration, which are the only ones to be written back
+    //Nothing for the first iteration, since transfer wrote everything
+    auto changedVSet = std::vector<int>();
+    bool *isChanged = new bool [vCount];
+    for(int i = 0; i < vCount; i++) isChanged[i] = false;
+
     //Test
     std::cout << "Init finished" << std::endl;
     //Test end
 
+    if(isConvergeMode)
+    {
+        auto &uc = clientVec.at(0);
+        uc.connect();
+
+        int runCount = uc.requestUntilConverged();
+
+        //Only vertices modified by the server are read back
+        for(int k = 0; k < *uc.modifiedVCount; k++)
+        {
+            int v = uc.modifiedVSet[k];
+            memcpy(&vValues[v * numOfInitV], &uc.vValues[v * numOfInitV], numOfInitV * sizeof(double));
+            vSet[v].isActive = uc.vSet[v].isActive;
+        }
+
+        uc.disconnect();
+
+        //Test
+        std::cout << "Converged after " << runCount << " supersteps" << std::endl;
+        //Test end
+
+        isActive = false;
+    }
+
+    if(isPeerMode)
+    {
+        for(int i = 0; i < nodeCount; i++)
+        {
+            clientVec.at(i).connect();
+            clientVec.at(i).requestPeerRun(RUN_UNTIL_CONVERGED);
+        }
+
+        int runCount = 0;
+        for(int i = 0; i < nodeCount; i++) runCount = clientVec.at(i).waitPeerRun();
+
+        //Every server has the whole result, so only vertices modified on node 0 are read back
+        auto &uc = clientVec.at(0);
+        for(int k = 0; k < *uc.modifiedVCount && runCount != -1; k++)
+        {
+            int v = uc.modifiedVSet[k];
+            memcpy(&vValues[v * numOfInitV], &uc.vValues[v * numOfInitV], numOfInitV * sizeof(double));
+            vSet[v].isActive = uc.vSet[v].isActive;
+        }
+
+        for(int i = 0; i < nodeCount; i++) clientVec.at(i).disconnect();
+
+        //Test
+        if(runCount == -1) std::cout << "Peer runs not supported, falling back to supersteps driven by the client" << std::endl;
+        else std::cout << "Converged after " << runCount << " supersteps" << std::endl;
+        //Test end
+
+        if(runCount != -1) isActive = false;
+    }
+
+    //Values of queries different from the reference, or -1 if servers refused them
+    int mismatchCount = 0;
+    if(isQueryMode)
+    {
+        for(int i = 0; i < nodeCount; i++) clientVec.at(i).connect();
+
+        //The last batch is not full
+        auto sources = std::vector<int>();
+        for(int q = 0; q < 3 * numOfInitV - 1; q++) sources.emplace_back(initVSet[q % numOfInitV]);
+        auto results = std::vector<double>((size_t)sources.size() * vCount);
+
+        int runCount = UtilClient<double, double>::query(clientVec, sources.data(), sources.size(), results.data());
+
+        for(int i = 0; i < nodeCount; i++) clientVec.at(i).disconnect();
+
+        //Results of the first batch are printed, and every query is checked against the reference from its source
+        auto referenceSet = std::vector<std::vector<double>>();
+        for(int j = 0; j < numOfInitV && runCount != -1; j++) referenceSet.emplace_back(referenceDistances(vCount, eSet, initVSet[j]));
+
+        for(int q = 0; q < sources.size() && runCount != -1; q++)
+        {
+            const auto &reference = referenceSet.at(q % numOfInitV);
+            for(int v = 0; v < vCount; v++)
+            {
+                double value = results[(size_t)q * vCount + v];
+                if(q < numOfInitV) vValues[v * numOfInitV + q] = value;
+                if(std::fabs(value - reference.at(v)) > 1e-9 * std::max(1.0, std::fabs(reference.at(v)))) mismatchCount++;
+            }
+        }
+        if(runCount == -1) mismatchCount = -1;
+
+        //Test
+        std::cout << "Queries: " << sources.size() << " in " << runCount << " runs, mismatched values: " << mismatchCount << std::endl;
+        //Test end
+
+        isActive = false;
+    }
+
     while(isActive)
     {
         //Test
@@ -145,32 +299,69 @@ int main(int argc, char *argv[])
 
         for(int i = 0; i < vCount; i++) ret_AVCheckSet[i] = false;
 
-        auto futList = new std::future<void> [nodeCount];
+        //Every server starts once its own data is written, while data of the next one is being written
         for(int i = 0; i < nodeCount; i++)
         {
-            std::future<void> tmpFut = std::async(testFut<double, double>, &clientVec.at(i), vValues, &vSet[0]);
-            futList[i] = std::move(tmpFut);
-        }
+            auto &uc = clientVec.at(i);
+            if(iterCount == 1) chk = uc.transfer(vValues, &vSet[0], &eSet[(i * eCount) / nodeCount], initVSet, filteredV, vCount);
+            else chk = uc.update(vValues, &vSet[0], changedVSet.data(), changedVSet.size());
 
-        for(int i = 0; i < nodeCount; i++)
-            futList[i].get();
+            if(chk == -1)
+            {
+                std::cout << "Parameter illegal" << std::endl;
+                return 3;
+            }
+
+            uc.sendRequest();
+        }
 
         //Retrieve data
+        for(int v : changedVSet) isChanged[v] = false;
+        changedVSet.clear();
+
+        //Modified vertices of every node are merged once it finishes, while the others may be still computing
+        int modifiedCount = 0;
+        bool isDense = false;
         for(int i = 0; i < nodeCount; i++)
         {
-            clientVec.at(i).connect();
+            auto &uc = clientVec.at(i);
+            uc.waitRequest();
+
+            modifiedCount += *uc.modifiedVCount;
+            isDense |= modifiedCount > vCount / GATHER_DENSE_RATIO;
+            if(isDense) continue;
 
-            //Collect data
-            for(int j = 0; j < vCount * numOfInitV; j++)
+            //Collect data of vertices modified by this server only
+            for(int k = 0; k < *uc.modifiedVCount; k++)
             {
-                if (clientVec.at(i).vValues[j] < vValues[j])
-                    vValues[j] = clientVec.at(i).vValues[j];
+                int v = uc.modifiedVSet[k];
+                for(int j = v * numOfInitV; j < (v + 1) * numOfInitV; j++)
+                {
+                    if (uc.vValues[j] < vValues[j])
+                        vValues[j] = uc.vValues[j];
+                }
+
+                ret_AVCheckSet[v] |= uc.vSet[v].isActive;
+
+                if(!isChanged[v])
+                {
+                    isChanged[v] = true;
+                    changedVSet.emplace_back(v);
+                }
             }
+        }
 
-            for(int j = 0; j < vCount; j++)
-                ret_AVCheckSet[j] |= clientVec.at(i).vSet[j].isActive;
+        //Whole segments of every node are reduced in parallel once most vertices are modified somewhere
+        //Values merged before are merged again, which does not change them
+        if(isDense)
+        {
+            isActive = UtilClient<double, double>::gather(clientVec, vValues, &vSet[0], &gatherPool) > 0;
 
-            clientVec.at(i).disconnect();
+            for(int v : changedVSet) isChanged[v] = false;
+            changedVSet.clear();
+            for(int i = 0; i < vCount; i++) changedVSet.emplace_back(i);
+
+            continue;
         }
 
         for(int i = 0; i < vCount; i++) vSet[i].isActive = ret_AVCheckSet[i];
@@ -188,4 +379,10 @@ int main(int argc, char *argv[])
         std::cout << "(" << initVSet[i % numOfInitV] << " -> " << vValues[i] << ")";
         if(i % numOfInitV == numOfInitV - 1) std::cout << std::endl;
     }
+
+    if(mismatchCount != 0)
+    {
+        std::cout << "Queries failed" << std::endl;
+        return 6;
+    }
 }
\ No newline at end of file
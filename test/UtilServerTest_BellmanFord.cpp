@@ -12,9 +12,9 @@
 
 int main(int argc, char *argv[])
 {
-    if(argc != 4 && argc != 5)
+    if(argc < 4 || argc > 7)
     {
-        std::cout << "Usage:" << std::endl << "./UtilServerTest_BellmanFord vCount eCount numOfInitV [nodeNo]" << std::endl;
+        std::cout << "Usage:" << std::endl << "./UtilServerTest_BellmanFord vCount eCount numOfInitV [nodeNo] [threadCount] [nodeCount]" << std::endl;
         return 1;
     }
 
@@ -22,6 +22,9 @@ int main(int argc, char *argv[])
     int eCount = atoi(argv[2]);
     int numOfInitV = atoi(argv[3]);
     int nodeNo = (argc == 4) ? 0 : atoi(argv[4]);
+    int threadCount = (argc >= 6) ? atoi(argv[5]) : 1;
+    //Nodes exchanging boundary values with each other for PEER_RUN_CMD
+    int nodeCount = (argc == 7) ? atoi(argv[6]) : 1;
 
     auto testUtilServer = UtilServer<BellmanFord<double, double>, double, double>(vCount, eCount, numOfInitV, nodeNo);
     if(!testUtilServer.isLegal)
@@ -30,5 +33,7 @@ int main(int argc, char *argv[])
         return 2;
     }
 
+    testUtilServer.threadCount = threadCount;
+    testUtilServer.nodeCount = nodeCount;
     testUtilServer.run();
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "../algo/PageRank/PageRank.h"
+#include "../core/GraphUtil.h"
+#include "../srv/UtilServer.h"
+#include "../srv/UNIX_shm.h"
+#include "../srv/UNIX_msg.h"
+
+#include <iostream>
+
+int main(int argc, char *argv[])
+{
+    if(argc < 4 || argc > 6)
+    {
+        std::cout << "Usage:" << std::endl << "./UtilServerTest_PageRank vCount eCount numOfInitV [nodeNo] [threadCount]" << std::endl;
+        return 1;
+    }
+
+    int vCount = atoi(argv[1]);
+    int eCount = atoi(argv[2]);
+    int numOfInitV = atoi(argv[3]);
+    int nodeNo = (argc == 4) ? 0 : atoi(argv[4]);
+    int threadCount = (argc == 6) ? atoi(argv[5]) : 1;
+
+    auto testUtilServer = UtilServer<PageRank<PRValue, double>, PRValue, double>(vCount, eCount, numOfInitV, nodeNo);
+    if(!testUtilServer.isLegal)
+    {
+        std::cout << "mem allocation failed or parameters are illegal" << std::endl;
+        return 2;
+    }
+
+    testUtilServer.threadCount = threadCount;
+    testUtilServer.run();
+}
@@ -5,6 +5,9 @@ ipcrm -M 0x00060000
 ipcrm -M 0x00070000
 ipcrm -M 0x00090000
 ipcrm -M 0x000a0000
+ipcrm -M 0x000b0000
+ipcrm -M 0x000c0000
+ipcrm -M 0x000d0000
 ipcrm -M 0x01010000
 ipcrm -M 0x01020000
 ipcrm -M 0x01030000
@@ -12,6 +15,9 @@ ipcrm -M 0x01060000
 ipcrm -M 0x01070000
 ipcrm -M 0x01090000
 ipcrm -M 0x010a0000
+ipcrm -M 0x010b0000
+ipcrm -M 0x010c0000
+ipcrm -M 0x010d0000
 ipcrm -M 0x02010000
 ipcrm -M 0x02020000
 ipcrm -M 0x02030000
@@ -19,6 +25,9 @@ ipcrm -M 0x02060000
 ipcrm -M 0x02070000
 ipcrm -M 0x02090000
 ipcrm -M 0x020a0000
+ipcrm -M 0x020b0000
+ipcrm -M 0x020c0000
+ipcrm -M 0x020d0000
 ipcrm -M 0x03010000
 ipcrm -M 0x03020000
 ipcrm -M 0x03030000
@@ -26,16 +35,38 @@ ipcrm -M 0x03060000
 ipcrm -M 0x03070000
 ipcrm -M 0x03090000
 ipcrm -M 0x030a0000
+ipcrm -M 0x030b0000
+ipcrm -M 0x030c0000
+ipcrm -M 0x030d0000
+
+ipcrm -M 0x000e0001
+ipcrm -M 0x000e0002
+ipcrm -M 0x000e0003
+ipcrm -M 0x000f0000
+ipcrm -M 0x010e0000
+ipcrm -M 0x010e0002
+ipcrm -M 0x010e0003
+ipcrm -M 0x010f0000
+ipcrm -M 0x020e0000
+ipcrm -M 0x020e0001
+ipcrm -M 0x020e0003
+ipcrm -M 0x020f0000
+ipcrm -M 0x030e0000
+ipcrm -M 0x030e0001
+ipcrm -M 0x030e0002
+ipcrm -M 0x030f0000
+ipcrm -M 0x00100000
+ipcrm -M 0x00110000
+ipcrm -M 0x01110000
+ipcrm -M 0x02110000
+ipcrm -M 0x03110000
+ipcrm -M 0x5b1e7d10
 
-ipcrm -Q 0x00000100
-ipcrm -Q 0x00000200
 ipcrm -Q 0x00000300
-ipcrm -Q 0x01000100
-ipcrm -Q 0x01000200
 ipcrm -Q 0x01000300
-ipcrm -Q 0x02000100
-ipcrm -Q 0x02000200
 ipcrm -Q 0x02000300
-ipcrm -Q 0x03000100
-ipcrm -Q 0x03000200
-ipcrm -Q 0x03000300
\ No newline at end of file
+ipcrm -Q 0x03000300
+ipcrm -Q 0xe89d03f4
+ipcrm -Q 0xe89d03f5
+
+rm -f /dev/shm/graph_algo_*
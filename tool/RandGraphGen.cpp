@@ -6,14 +6,21 @@
 #include <fstream>
 
 #include <random>
+#include <string>
 
 #define MAXEDGEWEIGHT 1000
 
+//Quadrant probabilities of R-MAT (Graph500), which give power-law degrees
+#define RMAT_A 0.57
+#define RMAT_B 0.19
+#define RMAT_C 0.19
+
 int main(int argc, char **argv)
 {
-    if(argc != 3) {std::cout << "Usage:" << std::endl << "./RandGraphGen vCount eCount" << std::endl; return 1; }
+    if(argc != 3 && !(argc == 4 && std::string("rmat") == argv[3])) {std::cout << "Usage:" << std::endl << "./RandGraphGen vCount eCount [rmat]" << std::endl; return 1; }
 
     int vCount = atoi(argv[1]), eCount = atoi(argv[2]);
+    bool isRMAT = argc == 4;
 
     std::random_device r1;
     std::uniform_int_distribution<int> uniform_dist_1(0, vCount - 1);
@@ -23,21 +30,49 @@ int main(int argc, char **argv)
     std::uniform_int_distribution<int> uniform_dist_2(0, MAXEDGEWEIGHT);
     std::default_random_engine e2(r2());
 
+    std::uniform_real_distribution<double> uniform_dist_3(0, 1);
+
+    int scale = 0;
+    while((1LL << scale) < vCount) scale++;
+
+    //R-MAT picks one quadrant of the adjacency matrix for each bit of src & dst
+    auto rmatVertexPair = [&](int &src, int &dst)
+    {
+        do
+        {
+            src = 0;
+            dst = 0;
+            for(int i = 0; i < scale; i++)
+            {
+                double p = uniform_dist_3(e1);
+                int srcBit = p >= RMAT_A + RMAT_B;
+                int dstBit = (p >= RMAT_A && p < RMAT_A + RMAT_B) || p >= RMAT_A + RMAT_B + RMAT_C;
+                src = (src << 1) | srcBit;
+                dst = (dst << 1) | dstBit;
+            }
+        }while(src >= vCount || dst >= vCount || src == dst);
+    };
+
     std::ofstream Gout("testGraph.txt");
 
     Gout << vCount << " " << eCount << std::endl;
     for(int i = 0; i < eCount; i++)
     {
-        int src = uniform_dist_1(e1), dst;
+        int src, dst;
         double weight = uniform_dist_2(e2);
-        do
+        if(isRMAT) rmatVertexPair(src, dst);
+        else
         {
-            dst = uniform_dist_1(e1);
-        }while(dst == src);
+            src = uniform_dist_1(e1);
+            do
+            {
+                dst = uniform_dist_1(e1);
+            }while(dst == src);
+        }
         Gout << src << " " << dst << " " << weight << std::endl;
     }
 
     Gout.close();
 
     return 0;
-}
\ No newline at end of file
+}
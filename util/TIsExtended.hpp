@@ -7,6 +7,8 @@
 #ifndef GRAPH_ALGO_TISEXTENDED_HPP
 #define GRAPH_ALGO_TISEXTENDED_HPP
 
+#include <cstddef>
+
 template<typename T, typename TBase>
 class TIsExtended
 {